@@ -2,6 +2,7 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -33,6 +34,18 @@ struct SSLConfig {
     bool enable_tls_key_logging{false};
     bool enforce_tls_1_3{false};
     std::filesystem::path tls_key_logging_path{};
+    // Stateless session tickets, so a reconnecting EV (i.e. after a pause) can skip the certificate exchange. A ticket
+    // stays valid for one to two rotation intervals, an interval of 0 disables the rotation.
+    bool enable_session_resumption{false};
+    uint32_t session_ticket_key_rotation_s{3600};
+    // keeps the ticket keys across restarts, if empty they are only kept in memory
+    std::filesystem::path session_ticket_key_file{};
+    // Kernel TLS, the kernel takes over the record encryption after the handshake. Falls back to OpenSSL, if the
+    // kernel, the OpenSSL build or the negotiated cipher suite doesn't support it.
+    bool enable_ktls{false};
+    // Threads running the handshake steps (signatures, certificate verification) instead of the event loops, so a
+    // handshake doesn't delay the other sessions. With 0, the handshakes run within the event loops.
+    uint32_t handshake_worker_threads{0};
 };
 
 } // namespace iso15118::config
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <iso15118/d20/control_event.hpp>
+
+namespace iso15118 {
+
+// Connectors keyed by their configured name, each one with at most one session. The session is owned by the shard
+// (event loop) the connector has been assigned to and is only touched within the thread of that shard.
+//
+// The connector type needs to provide:
+//   std::mutex mutex;                   protects shard and session
+//   Shard* shard;                       shard owning the session (with a post() member), nullptr if none is running
+//   std::unique_ptr<Session> session;   session of the connector
+template <typename Connector> class ConnectorTable {
+public:
+    // returns nullptr, if the name is already used. NOTE: the first added connector is the default one
+    Connector* add(const std::string& name) {
+        auto [it, inserted] = connectors.try_emplace(name);
+        if (not inserted) {
+            return nullptr;
+        }
+
+        if (connectors.size() == 1) {
+            default_connector = name;
+        }
+
+        return &it->second;
+    }
+
+    Connector& get(const std::string& name) {
+        const auto it = connectors.find(name);
+        if (it == connectors.end()) {
+            throw std::runtime_error("Unknown connector: " + name);
+        }
+
+        return it->second;
+    }
+
+    const std::string& get_default_name() const {
+        return default_connector;
+    }
+
+    // NOTE: can be called from any thread
+    void push_control_event(const std::string& name, const d20::ControlEvent& event) {
+        auto& connector = get(name);
+
+        std::scoped_lock lock(connector.mutex);
+        push_control_event(connector, event);
+    }
+
+    // NOTE: the mutex of the connector needs to be locked
+    static void push_control_event(Connector& connector, const d20::ControlEvent& event) {
+        const auto shard = connector.shard;
+        if (shard == nullptr) {
+            // no session running
+            return;
+        }
+
+        // the session handles the event right after the wakeup of its shard, without waiting for a timeout
+        shard->post([&connector, shard, event]() {
+            std::scoped_lock lock(connector.mutex);
+            // the session might have finished in the meantime
+            if (connector.shard == shard and connector.session) {
+                connector.session->push_control_event(event);
+            }
+        });
+    }
+
+    auto begin() {
+        return connectors.begin();
+    }
+
+    auto end() {
+        return connectors.end();
+    }
+
+private:
+    // NOTE: std::map, because the sessions and sdp callbacks keep references into the connectors
+    std::map<std::string, Connector> connectors;
+    std::string default_connector;
+};
+
+} // namespace iso15118
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -11,6 +12,9 @@
 
 namespace iso15118::d20 {
 
+// forward declare
+class ResponseTemplateCache;
+
 struct ControlMobilityNeedsModes {
     message_20::datatypes::ControlMode control_mode;
     message_20::datatypes::MobilityNeedsMode mobility_mode;
@@ -40,6 +44,8 @@ struct EvseSetupConfig {
     std::optional<AcSetupConfig> ac_setup_config{std::nullopt};
     std::optional<BptSetupConfig> bpt_setup_config{std::nullopt};
     d20::DcTransferLimits powersupply_limits;
+    // keep only the newest measurement or limit per type, until the session handles its control events
+    bool coalesce_control_events{false};
 };
 
 // This should only have EVSE information
@@ -73,6 +79,11 @@ struct SessionConfig {
     std::vector<ControlMobilityNeedsModes> supported_control_mobility_modes;
 
     std::optional<std::string> custom_protocol{std::nullopt};
+
+    bool coalesce_control_events{false};
+
+    // shared by the sessions using the same version of this config, might be null
+    std::shared_ptr<ResponseTemplateCache> response_templates{nullptr};
 };
 
 } // namespace iso15118::d20
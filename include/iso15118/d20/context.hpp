@@ -2,11 +2,12 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
-#include <any>
 #include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include <iso15118/d20/timeout.hpp>
 #include <iso15118/message/payload_type.hpp>
@@ -18,6 +19,8 @@
 #include "control_event.hpp"
 #include "ev_information.hpp"
 #include "ev_session_info.hpp"
+#include "output_buffers.hpp"
+#include "response_template_cache.hpp"
 #include "session.hpp"
 
 namespace iso15118::d20 {
@@ -25,47 +28,126 @@ namespace iso15118::d20 {
 // forward declare
 class ControlEventQueue;
 
+enum class ResponseRetention {
+    NONE, // responses are only serialized
+    LAST, // the last response is kept for get_response(), i.e. for inspecting it in tests
+};
+
 class MessageExchange {
 public:
-    MessageExchange(io::StreamOutputView);
+    // NOTE: responses, that don't fit into the view, can't be encoded
+    MessageExchange(io::StreamOutputView, ResponseRetention = ResponseRetention::NONE);
+    // NOTE: responses, that don't fit into a buffer of the pool, are encoded again into the next larger one
+    MessageExchange(OutputBufferPool&, ResponseRetention = ResponseRetention::NONE);
+
+    // NOTE: the request gets decoded into the storage of the previous one, so the received messages don't allocate.
+    // Only its type is peeked here, the state decodes it by accessing the expected message type. The payload needs to
+    // stay valid until the request has been handled.
+    void set_request(io::v2gtp::PayloadType, const io::StreamInputView&);
+    template <typename MessageType> void set_request(const MessageType& msg) {
+        check_request_handled();
+        request.emplace(msg);
+        request_available = true;
+    }
 
-    void set_request(std::unique_ptr<message_20::Variant> new_request);
-    std::unique_ptr<message_20::Variant> pull_request();
+    // NOTE: the returned request stays valid until the next one is set
+    const message_20::Variant* pull_request();
     message_20::Type peek_request_type() const;
+    // to be called once the frame of the request has been handled, its payload gets overwritten afterwards
+    void release_request_payload();
 
-    template <typename MessageType> void set_response(const MessageType& msg) {
-        response_size = message_20::serialize(msg, response);
-        response_available = true;
-        payload_type = message_20::PayloadTypeTrait<MessageType>::type;
-        response_type = message_20::TypeTrait<MessageType>::type;
-        response_message = msg;
+    template <typename MessageType> void set_response(MessageType&& msg) {
+        const auto size =
+            encode([&](const io::StreamOutputView& out) { return message_20::serialize(msg, out, codec); });
+        store_response(std::forward<MessageType>(msg), size);
     }
 
+    template <typename MessageType>
+    void set_response(MessageType&& msg, ResponseTemplateCache& templates, uint32_t key) {
+        const auto size =
+            encode([&](const io::StreamOutputView& out) { return templates.encode(msg, key, out, codec); });
+        store_response(std::forward<MessageType>(msg), size);
+    }
+
+    // NOTE: only available with ResponseRetention::LAST
     template <typename Msg> std::optional<Msg> get_response() {
         static_assert(message_20::TypeTrait<Msg>::type != message_20::Type::None, "Unhandled type!");
         if (message_20::TypeTrait<Msg>::type != response_type) {
             return std::nullopt;
         }
-        try {
-            return std::any_cast<Msg>(response_message);
-        } catch (const std::bad_any_cast& ex) {
-            return std::nullopt;
+
+        if (const auto msg = response_message.get_if<Msg>()) {
+            return *msg;
         }
+
+        return std::nullopt;
     }
 
     std::tuple<bool, size_t, io::v2gtp::PayloadType, message_20::Type> check_and_clear_response();
 
+    // the output the last response has been encoded into, stays valid until the next response is set
+    const io::StreamOutputView& get_response_view() const {
+        return response;
+    }
+
+    const EncodedSizeStatistics& get_encoded_size_stats() const {
+        return encoded_size_stats;
+    }
+
 private:
+    void check_request_handled() const;
+
+    // returns false, if there is no such buffer
+    bool select_output_buffer(size_t size_class);
+
+    template <typename EncodeFunction> size_t encode(const EncodeFunction& encode_into) {
+        select_output_buffer(0);
+
+        while (true) {
+            try {
+                return encode_into(response);
+            } catch (const message_20::EncodingBufferOverflow&) {
+                if (not select_output_buffer(response_size_class + 1)) {
+                    throw;
+                }
+            }
+        }
+    }
+
+    template <typename MessageType> void store_response(MessageType&& msg, size_t size) {
+        using Message = std::decay_t<MessageType>;
+
+        response_size = size;
+        response_available = true;
+        payload_type = message_20::PayloadTypeTrait<Message>::type;
+        response_type = message_20::TypeTrait<Message>::type;
+
+        encoded_size_stats.add(response_type, size, response_size_class);
+
+        if (retention == ResponseRetention::LAST) {
+            // NOTE: the storage of the previous response gets reused
+            response_message.emplace(std::forward<MessageType>(msg));
+        }
+    }
+
+    // reused for decoding the requests and encoding the responses
+    message_20::CodecContext codec;
+
     // input
-    std::unique_ptr<message_20::Variant> request{nullptr};
+    message_20::Variant request;
+    bool request_available{false};
 
     // output
-    const io::StreamOutputView response;
+    OutputBufferPool* const output_buffers{nullptr};
+    io::StreamOutputView response;
+    size_t response_size_class{0};
     size_t response_size{0};
     bool response_available{false};
     io::v2gtp::PayloadType payload_type;
     message_20::Type response_type;
-    std::any response_message;
+    const ResponseRetention retention;
+    message_20::Variant response_message;
+    EncodedSizeStatistics encoded_size_stats;
 };
 
 std::unique_ptr<MessageExchange> create_message_exchange(uint8_t* buf, const size_t len);
@@ -83,11 +165,21 @@ public:
         return std::make_unique<StateType>(*this, std::forward<Args>(args)...);
     }
 
-    std::unique_ptr<message_20::Variant> pull_request();
+    const message_20::Variant* pull_request();
     message_20::Type peek_request_type() const;
 
-    template <typename MessageType> void respond(const MessageType& msg) {
-        message_exchange.set_response(msg);
+    template <typename MessageType> void respond(MessageType&& msg) {
+        message_exchange.set_response(std::forward<MessageType>(msg));
+    }
+
+    // NOTE: only for responses, whose content (besides the header) is fully determined by the session config and the
+    // key. Changing the session config during the session needs to drop its response templates.
+    template <typename MessageType> void respond_from_template(const MessageType& msg, uint32_t key) {
+        if (session_config.response_templates) {
+            message_exchange.set_response(msg, *session_config.response_templates, key);
+        } else {
+            message_exchange.set_response(msg);
+        }
     }
 
     template <typename Msg> std::optional<Msg> get_response() {
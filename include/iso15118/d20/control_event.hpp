@@ -91,4 +91,13 @@ using ControlEvent = std::variant<CableCheckFinished, PresentVoltageCurrent, Aut
                                   PauseCharging, DcTransferLimits, AcTransferLimits, UpdateDynamicModeParameters,
                                   ClosedContactor, AcTargetPower, AcPresentPower, EnergyServices, SupportedVASs>;
 
+// State like events (measurements and limits) are superseded by a newer event of the same type, all others are edge
+// events and need to be handled in order
+inline bool is_state_control_event(const ControlEvent& event) {
+    return std::holds_alternative<PresentVoltageCurrent>(event) or std::holds_alternative<DcTransferLimits>(event) or
+           std::holds_alternative<AcTransferLimits>(event) or
+           std::holds_alternative<UpdateDynamicModeParameters>(event) or
+           std::holds_alternative<AcTargetPower>(event) or std::holds_alternative<AcPresentPower>(event);
+}
+
 } // namespace iso15118::d20
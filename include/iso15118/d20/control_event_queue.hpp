@@ -2,22 +2,82 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <utility>
 
 #include "control_event.hpp"
 
 namespace iso15118::d20 {
 
+// NOTE: only applies to state like events (see is_state_control_event()), edge events are never discarded
+enum class ControlEventOverflowPolicy {
+    DROP_NEWEST,      // the pushed event gets discarded
+    OVERWRITE_OLDEST, // the oldest queued state event gets discarded to make room
+};
+
+// Multi producer, single consumer queue. State like events go through a bounded lock-free ring, whose slots are
+// allocated up front, so pushing them does not allocate (besides copying the event itself). As they are superseded by
+// newer ones anyway, they might get discarded if the ring is full. Edge events are rare but must not get lost, so they
+// are kept in an unbounded list guarded by a mutex. Both are popped in the order they have been pushed.
 class ControlEventQueue {
 public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+    // NOTE: the capacity gets rounded up to the next power of two
+    explicit ControlEventQueue(
+        std::size_t capacity = DEFAULT_CAPACITY,
+        ControlEventOverflowPolicy overflow_policy = ControlEventOverflowPolicy::OVERWRITE_OLDEST);
+    ~ControlEventQueue();
+
+    ControlEventQueue(const ControlEventQueue&) = delete;
+    ControlEventQueue& operator=(const ControlEventQueue&) = delete;
+
+    // NOTE: only to be called by the consumer
     std::optional<ControlEvent> pop();
-    void push(ControlEvent);
+
+    // returns false, if a state event got discarded because the ring was full
+    bool push(ControlEvent);
+
+    std::size_t get_capacity() const {
+        return mask + 1;
+    }
+
+    std::size_t get_dropped_count() const {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
 
 private:
-    std::queue<ControlEvent> queue;
-    std::mutex mutex;
+    struct Slot;
+    // push order and event
+    using Entry = std::pair<uint64_t, ControlEvent>;
+
+    bool try_push(Entry&);
+    // NOTE: called by the consumer and by producers overwriting the oldest state event
+    std::optional<Entry> pop_state_event();
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    ControlEventOverflowPolicy overflow_policy;
+
+    // NOTE: kept on separate cache lines, producers and consumer would invalidate each other otherwise
+    alignas(64) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos{0};
+    alignas(64) std::atomic<std::size_t> dropped_count{0};
+    alignas(64) std::atomic<uint64_t> push_order{0};
+
+    std::mutex edge_events_mutex;
+    std::deque<Entry> edge_events;
+    // lets the consumer skip the mutex, while there are no edge events
+    std::atomic<std::size_t> edge_event_count{0};
+
+    // state event taken from the ring by the consumer, that is still waiting for older edge events
+    std::optional<Entry> pending_state_event;
 };
 
 } // namespace iso15118::d20
@@ -41,4 +41,35 @@ struct AcTransferLimits {
     std::optional<Limit<dt::RationalNumber>> discharge_power_L3;
 };
 
+// The transfer limits in plain numbers (W, A, V, Hz), i.e. as reported by the power supply. They are converted as a
+// whole with one batch conversion.
+struct LimitValues {
+    Limit<float> power;
+    Limit<float> current;
+};
+
+struct DcTransferLimitValues {
+    LimitValues charge_limits;
+    std::optional<LimitValues> discharge_limits;
+    Limit<float> voltage;
+    std::optional<float> power_ramp_limit;
+};
+
+struct AcTransferLimitValues {
+    Limit<float> charge_power;
+    std::optional<Limit<float>> charge_power_L2;
+    std::optional<Limit<float>> charge_power_L3;
+
+    float nominal_frequency;
+    std::optional<float> max_power_asymmetry;
+    std::optional<float> power_ramp_limitation;
+
+    std::optional<Limit<float>> discharge_power;
+    std::optional<Limit<float>> discharge_power_L2;
+    std::optional<Limit<float>> discharge_power_L3;
+};
+
+DcTransferLimits convert_limits(const DcTransferLimitValues&);
+AcTransferLimits convert_limits(const AcTransferLimitValues&);
+
 } // namespace iso15118::d20
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <iso15118/io/stream_view.hpp>
+#include <iso15118/message/type.hpp>
+
+namespace iso15118::d20 {
+
+// Output buffers of increasing size classes for the encoded responses. Every response is encoded into the smallest one
+// first, a larger one is only used (and allocated on first use), if the response didn't fit.
+// NOTE: each buffer reserves header_size bytes in front of its payload, i.e. for the V2GTP header
+class OutputBufferPool {
+public:
+    // total buffer sizes, including the reserved header
+    static constexpr std::array<std::size_t, 4> SIZE_CLASSES = {1028, 4096, 16384, 65536};
+    static constexpr std::size_t SIZE_CLASS_COUNT = SIZE_CLASSES.size();
+
+    explicit OutputBufferPool(std::size_t header_size = 0);
+
+    io::StreamOutputView get_payload_view(std::size_t size_class);
+
+private:
+    const std::size_t header_size;
+    std::array<std::unique_ptr<uint8_t[]>, SIZE_CLASS_COUNT> buffers;
+};
+
+struct EncodedSizeStats {
+    uint32_t count{0};
+    std::size_t max_size{0};
+    std::size_t total_size{0};
+    // number of responses per size class of the buffer they were finally encoded into
+    std::array<uint32_t, OutputBufferPool::SIZE_CLASS_COUNT> size_class_counts{};
+};
+
+// encoded sizes of the responses per message type
+class EncodedSizeStatistics {
+public:
+    void add(message_20::Type, std::size_t size, std::size_t size_class);
+
+    const EncodedSizeStats& get(message_20::Type type) const {
+        return stats[message_20::to_index(type)];
+    }
+
+private:
+    std::array<EncodedSizeStats, message_20::TYPE_COUNT> stats{};
+};
+
+} // namespace iso15118::d20
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <iso15118/io/stream_view.hpp>
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/common_types.hpp>
+#include <iso15118/message/type.hpp>
+
+namespace iso15118::d20 {
+
+// Encoded responses, whose content only depends on the session config and a small key derived from the request. Once
+// a response has been encoded, following ones only copy the template and patch in the session id and the timestamp of
+// their header.
+// NOTE: a cache belongs to one version of the config, so it needs to be replaced if the config changes. It might be
+// shared between the sessions of different threads.
+class ResponseTemplateCache {
+public:
+    static constexpr std::size_t MAX_TEMPLATES = 32;
+
+    // returns the encoded size, like message_20::serialize()
+    template <typename MessageType>
+    std::size_t encode(const MessageType& msg, uint32_t key, const io::StreamOutputView& out,
+                       message_20::CodecContext& codec) {
+        constexpr auto type = message_20::TypeTrait<MessageType>::type;
+
+        if constexpr (has_header<MessageType>::value) {
+            if (const auto size = apply(type, key, &msg.header, out); size != 0) {
+                return size;
+            }
+
+            const auto size = message_20::serialize(msg, out, codec);
+
+            // encoding the message once more with all header bits of interest flipped reveals their positions
+            auto probe = msg;
+            for (auto& byte : probe.header.session_id) {
+                byte = ~byte;
+            }
+            probe.header.timestamp ^= 1;
+
+            std::vector<uint8_t> probe_buffer(size);
+            const auto probe_size = message_20::serialize(probe, {probe_buffer.data(), probe_buffer.size()}, codec);
+            if (probe_size == size) {
+                add(type, key, {out.payload, size}, probe_buffer, &msg.header);
+            }
+
+            return size;
+        } else {
+            if (const auto size = apply(type, key, nullptr, out); size != 0) {
+                return size;
+            }
+
+            const auto size = message_20::serialize(msg, out, codec);
+            add(type, key, {out.payload, size}, {}, nullptr);
+
+            return size;
+        }
+    }
+
+    std::size_t size() const;
+
+private:
+    template <typename T, typename = void> struct has_header : std::false_type {};
+    template <typename T>
+    struct has_header<T, std::void_t<decltype(std::declval<T>().header)>>
+        : std::is_same<decltype(std::declval<T>().header), message_20::Header> {};
+
+    struct Template {
+        std::vector<uint8_t> exi;
+        std::size_t session_id_bit_offset;
+        std::size_t timestamp_bit_offset;
+        std::size_t timestamp_size; // in bytes
+    };
+
+    // returns 0, if there is no template or it can't be patched with this header
+    std::size_t apply(message_20::Type, uint32_t key, const message_20::Header*, const io::StreamOutputView&) const;
+    void add(message_20::Type, uint32_t key, const io::StreamInputView& exi, const std::vector<uint8_t>& probe_exi,
+             const message_20::Header*);
+
+    mutable std::mutex mutex;
+    std::map<std::pair<message_20::Type, uint32_t>, Template> templates;
+};
+
+} // namespace iso15118::d20
@@ -4,8 +4,11 @@
 
 #include "../states.hpp"
 
+#include <optional>
+
 #include <iso15118/d20/ac_powers.hpp>
 #include <iso15118/d20/dynamic_mode_parameters.hpp>
+#include <iso15118/message/ac_charge_loop.hpp>
 
 namespace iso15118::d20::state {
 struct AC_ChargeLoop : public StateBase {
@@ -25,6 +28,10 @@ private:
     AcTargetPower target_powers{};
     AcPresentPower present_powers{};
 
+    // refreshed only if the powers or the dynamic mode parameters change
+    std::optional<decltype(message_20::AC_ChargeLoopResponse::control_mode)> control_mode_response;
+    bool control_mode_response_outdated{true};
+
     bool first_entry_in_charge_loop{false};
 };
 
@@ -8,6 +8,7 @@
 #include <optional>
 
 #include <iso15118/d20/dynamic_mode_parameters.hpp>
+#include <iso15118/message/dc_charge_loop.hpp>
 
 namespace iso15118::d20::state {
 
@@ -27,6 +28,10 @@ private:
 
     UpdateDynamicModeParameters dynamic_parameters;
 
+    // refreshed only if the limits or the dynamic mode parameters change
+    std::optional<decltype(message_20::DC_ChargeLoopResponse::control_mode)> control_mode_response;
+    bool control_mode_response_outdated{true};
+
     bool first_entry_in_charge_loop{true};
 };
 
@@ -39,6 +39,8 @@ public:
     void stop_timeout(TimeoutType type);
     void reset_timeout(TimeoutType type);
     std::optional<std::vector<TimeoutType>> check();
+    // earliest time point of all started timeouts
+    std::optional<TimePoint> get_next_deadline() const;
 
 private:
     std::array<std::optional<Timeout>, TIMEOUT_TYPE_SIZE> timeouts;
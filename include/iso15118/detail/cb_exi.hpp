@@ -5,8 +5,11 @@
 #include <stdexcept>
 
 #include <cbv2g/common/exi_bitstream.h>
+#include <cbv2g/common/exi_error_codes.h>
 
 #include <iso15118/io/stream_view.hpp>
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/type.hpp>
 
 #define CB2CPP_STRING(property) (std::string(property.characters, property.charactersLen))
 
@@ -81,13 +84,17 @@ exi_bitstream_t get_exi_output_stream(const iso15118::io::StreamOutputView&);
 
 namespace iso15118::message_20 {
 
-template <typename MessageType> int serialize_to_exi(const MessageType& in, exi_bitstream_t& out);
+template <typename MessageType> int serialize_to_exi(const MessageType& in, exi_bitstream_t& out, CodecContext& codec);
 
 template <typename MessageType>
-size_t serialize_helper(const MessageType& in, const io::StreamOutputView& stream_view) {
+size_t serialize_helper(const MessageType& in, const io::StreamOutputView& stream_view, CodecContext& codec) {
     auto out = get_exi_output_stream(stream_view);
 
-    const auto error = serialize_to_exi(in, out);
+    const auto error = serialize_to_exi(in, out, codec);
+
+    if (error == EXI_ERROR__BITSTREAM_OVERFLOW) {
+        throw EncodingBufferOverflow("Could not encode exi: output buffer too small");
+    }
 
     if (error != 0) {
         throw std::runtime_error("Could not encode exi: " + std::to_string(error));
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <iso15118/message/codec_context.hpp>
+
+#include <cbv2g/app_handshake/appHand_Datatypes.h>
+#include <cbv2g/iso_20/iso20_AC_Datatypes.h>
+#include <cbv2g/iso_20/iso20_CommonMessages_Datatypes.h>
+#include <cbv2g/iso_20/iso20_DC_Datatypes.h>
+
+namespace iso15118::message_20 {
+
+// NOTE: decoding a request and encoding its response never overlap, so the same documents are used for both. The
+// init_*_exiDocument functions only reset the used flags, the branch itself gets initialized by its conversion.
+struct CodecContext::Documents {
+    appHand_exiDocument app_hand;
+    iso20_exiDocument main;
+    iso20_dc_exiDocument dc;
+    iso20_ac_exiDocument ac;
+};
+
+} // namespace iso15118::message_20
@@ -2,6 +2,8 @@
 // Copyright 205 Pionix GmbH and Contributors to EVerest
 #pragma once
 
+#include <optional>
+
 #include <iso15118/d20/session.hpp>
 #include <iso15118/message/ac_charge_loop.hpp>
 
@@ -11,10 +13,32 @@
 
 namespace iso15118::d20::state {
 
+using AC_ControlModeResponse = decltype(message_20::AC_ChargeLoopResponse::control_mode);
+
+// The control mode block of the response only depends on the selected services, the target and present powers and the
+// dynamic mode parameters, so it is kept until one of them changes. Returns std::nullopt, if the selected services are
+// no ac ones.
+std::optional<AC_ControlModeResponse>
+create_control_mode_response(const SelectedServiceParameters& selected_services, const AcTargetPower& target_powers,
+                             const AcPresentPower& present_powers,
+                             const UpdateDynamicModeParameters& dynamic_parameters);
+
 message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoopRequest& req,
                                                  const d20::Session& session, bool stop, bool pause,
                                                  float target_frequency, const AcTargetPower& target_powers,
                                                  const AcPresentPower& present_powers,
                                                  const UpdateDynamicModeParameters& dynamic_parameters);
 
+message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, bool stop, bool pause,
+                                                 float target_frequency, const AcTargetPower& target_powers,
+                                                 const AcPresentPower& present_powers,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters);
+
+message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, bool stop, bool pause,
+                                                 float target_frequency,
+                                                 const std::optional<AC_ControlModeResponse>& control_mode,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters);
+
 } // namespace iso15118::d20::state
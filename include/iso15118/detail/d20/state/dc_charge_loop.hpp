@@ -17,10 +17,31 @@
 
 namespace iso15118::d20::state {
 
+using DC_ControlModeResponse = decltype(message_20::DC_ChargeLoopResponse::control_mode);
+
+// The control mode block of the response only depends on the selected services, the limits and the dynamic mode
+// parameters, so it is kept until one of them changes. Returns std::nullopt, if the selected services are no dc ones or
+// bpt is selected without discharge limits.
+std::optional<DC_ControlModeResponse>
+create_control_mode_response(const SelectedServiceParameters& selected_services, const DcTransferLimits& dc_limits,
+                             const UpdateDynamicModeParameters& dynamic_parameters);
+
 message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoopRequest& req,
                                                  const d20::Session& session, const float present_voltage,
                                                  const float present_current, const bool stop, const bool pause,
                                                  const DcTransferLimits& dc_limits,
                                                  const UpdateDynamicModeParameters& dynamic_parameters);
 
+message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, const float present_voltage,
+                                                 const float present_current, const bool stop, const bool pause,
+                                                 const DcTransferLimits& dc_limits,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters);
+
+message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, const float present_voltage,
+                                                 const float present_current, const bool stop, const bool pause,
+                                                 const std::optional<DC_ControlModeResponse>& control_mode,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters);
+
 } // namespace iso15118::d20::state
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+
+namespace iso15118::io {
+
+struct SessionTicketKey {
+    static constexpr std::size_t NAME_LENGTH = 16;
+
+    std::array<uint8_t, NAME_LENGTH> name;
+    std::array<uint8_t, 32> aes_key;
+    std::array<uint8_t, 32> hmac_key;
+    int64_t created_at; // seconds since epoch
+};
+
+struct SessionTicketKeyLookup {
+    SessionTicketKey key;
+    bool renew_ticket; // the ticket was encrypted with the previous key
+};
+
+// Keys for the stateless TLS session tickets. New tickets are encrypted with the current key, the previous one is kept
+// for decrypting the tickets issued before the last rotation. So a ticket stays valid for one to two rotation
+// intervals.
+// NOTE: with a file, the keys survive restarts and can be shared between processes
+class SessionTicketKeyStore {
+public:
+    using Clock = std::chrono::system_clock;
+
+    // NOTE: a rotation interval of 0 disables the rotation, an empty file path keeps the keys in memory only
+    SessionTicketKeyStore(std::chrono::seconds rotation_interval, std::filesystem::path file);
+
+    SessionTicketKey get_encryption_key(Clock::time_point now = Clock::now());
+    // returns std::nullopt, if the key is unknown or expired
+    std::optional<SessionTicketKeyLookup> find_decryption_key(const uint8_t* name,
+                                                              Clock::time_point now = Clock::now());
+
+private:
+    void rotate_if_needed(int64_t now);
+    bool load();
+    void save() const;
+
+    const int64_t rotation_interval;
+    const std::filesystem::path file;
+
+    std::mutex mutex;
+    SessionTicketKey current;
+    std::optional<SessionTicketKey> previous;
+};
+
+} // namespace iso15118::io
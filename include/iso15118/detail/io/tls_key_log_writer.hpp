@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace iso15118::io {
+
+class TlsKeyLoggingServer;
+
+// Sink for the TLS key log lines (NSS key log format). The lines are buffered in memory and written to the file, the
+// log and the key logging servers by a background thread, so the handshakes don't wait for any of them.
+// NOTE: the file is opened once and kept open for all sessions
+class TlsKeyLogWriter {
+public:
+    explicit TlsKeyLogWriter(const std::filesystem::path& file);
+    // NOTE: waits until all pending lines have been written
+    ~TlsKeyLogWriter();
+
+    TlsKeyLogWriter(const TlsKeyLogWriter&) = delete;
+    TlsKeyLogWriter& operator=(const TlsKeyLogWriter&) = delete;
+
+    // NOTE: the key logging server is kept alive, until the line has been sent
+    void push(const char* line, std::shared_ptr<TlsKeyLoggingServer> server);
+
+private:
+    struct Entry {
+        std::string line;
+        std::shared_ptr<TlsKeyLoggingServer> server;
+    };
+
+    void run();
+    void write(std::vector<Entry>& entries);
+
+    int fd{-1};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Entry> pending;
+    bool running{true};
+
+    std::thread thread;
+};
+
+} // namespace iso15118::io
@@ -15,19 +15,13 @@ struct VariantAccess {
     exi_bitstream_t input_stream;
 
     // output
-    void*& data;
-    iso15118::message_20::Type& type;
-    iso15118::message_20::Variant::CustomDeleter& custom_deleter;
+    iso15118::message_20::Variant& variant;
     std::string& error;
 
     template <typename MessageType, typename CbExiMessageType> void insert_type(const CbExiMessageType& in) {
-        assert(data == nullptr);
+        assert(variant.data == nullptr);
 
-        data = new MessageType;
-        type = iso15118::message_20::TypeTrait<MessageType>::type;
-        custom_deleter = [](void* ptr) { delete static_cast<MessageType*>(ptr); };
-
-        convert(in, *static_cast<MessageType*>(data));
+        convert(in, variant.create<MessageType>());
     };
 };
 
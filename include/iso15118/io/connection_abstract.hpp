@@ -3,10 +3,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
 
 #include "ipv6_endpoint.hpp"
+#include "output_queue.hpp"
 
 #include <iso15118/io/sha_hash.hpp>
 
@@ -31,13 +33,19 @@ struct IConnection {
 
     virtual Ipv6EndPoint get_public_endpoint() const = 0;
 
+    // NOTE: never blocks, whatever can't be written right away is queued and flushed once the socket is writable
     virtual void write(const uint8_t* buf, size_t len) = 0;
     virtual ReadResult read(uint8_t* buf, size_t len) = 0;
 
     virtual void close() = 0;
+    // Non-blocking graceful close: waits up to linger_ms for the peer to close the connection first, then shuts down
+    // our side and waits for the peer's FIN. ConnectionEvent::CLOSED is signaled, once the connection is closed.
+    virtual void linger_and_close(uint32_t linger_ms) = 0;
 
     virtual std::optional<sha512_hash_t> get_vehicle_cert_hash() const = 0;
 
+    virtual OutputQueueStats get_output_queue_stats() const = 0;
+
     virtual ~IConnection() = default;
 };
 } // namespace iso15118::io
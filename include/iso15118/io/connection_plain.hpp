@@ -4,6 +4,8 @@
 
 #include "connection_abstract.hpp"
 
+#include <optional>
+
 #include <iso15118/config.hpp>
 #include <iso15118/io/poll_manager.hpp>
 
@@ -20,11 +22,16 @@ public:
     ReadResult read(uint8_t* buf, size_t len) final;
 
     void close() final;
+    void linger_and_close(uint32_t linger_ms) final;
 
     std::optional<sha512_hash_t> get_vehicle_cert_hash() const final {
         return std::nullopt;
     }
 
+    OutputQueueStats get_output_queue_stats() const final {
+        return output_queue.get_stats();
+    }
+
     ~ConnectionPlain();
 
 private:
@@ -38,7 +45,31 @@ private:
 
     ConnectionEventCallback event_callback{nullptr};
 
+    OutputQueue output_queue;
+
+    enum class CloseState {
+        NONE,
+        LINGER,
+        WAIT_FOR_FIN,
+        CLOSED,
+    };
+
+    CloseState close_state{CloseState::NONE};
+    bool peer_closed{false};
+    std::optional<TimerId> close_timer{std::nullopt};
+
+    // runs a poll callback, an error only tears down this connection and not the event loop shared with other sessions
+    void run_guarded(void (ConnectionPlain::*handler)());
+
     void handle_connect();
     void handle_data();
+
+    void handle_writable();
+    // returns false, if the connection broke
+    bool flush_output_queue();
+
+    void handle_closing_data();
+    void shutdown_connection();
+    void finish_close();
 };
 } // namespace iso15118::io
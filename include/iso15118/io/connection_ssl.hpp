@@ -3,20 +3,89 @@
 #pragma once
 #include "connection_abstract.hpp"
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include <iso15118/config.hpp>
 #include <iso15118/io/poll_manager.hpp>
 #include <iso15118/io/sha_hash.hpp>
+#include <iso15118/io/worker_pool.hpp>
+
+// forward declaration of SSL_CTX
+struct ssl_ctx_st;
 
 namespace iso15118::io {
 
+struct TlsHandshakeStats {
+    uint32_t full_handshakes{0};
+    uint32_t resumed_handshakes{0}; // from a session ticket, without certificate exchange
+    // handshakes, after which the kernel took over sending/receiving the records (kTLS)
+    uint32_t ktls_send{0};
+    uint32_t ktls_receive{0};
+};
+
+// forward declaration
+struct SSLServerState;
+
+// TLS server setup (certificate chain, private key and verify roots), built once from the config and shared by all ssl
+// connections. A reload builds a new setup from the files and swaps it in for the following connections, the current
+// ones keep using the previous one.
+class SSLServerContext {
+public:
+    // NOTE: a failed load is only logged, get() returns nullptr until a reload succeeds
+    explicit SSLServerContext(const config::SSLConfig&);
+    ~SSLServerContext();
+
+    // returns false and keeps the current setup, if the files could not be loaded
+    bool reload();
+
+    // watches the directories of the certificate files (EVEREST_LAYOUT only), handle_file_events() needs to be called
+    // once the returned inotify fd is readable. Returns -1 on failure.
+    int start_watching();
+    // returns true, if a certificate file changed and the setup has been reloaded successfully
+    bool handle_file_events();
+
+    std::shared_ptr<ssl_ctx_st> get() const;
+
+    // NOTE: accumulated over all reloads
+    TlsHandshakeStats get_handshake_stats() const;
+
+    const config::SSLConfig& get_config() const {
+        return config;
+    }
+
+    // nullptr, if the handshakes run within the event loops
+    const std::shared_ptr<WorkerPool>& get_handshake_workers() const {
+        return handshake_workers;
+    }
+
+private:
+    const config::SSLConfig config;
+
+    std::shared_ptr<WorkerPool> handshake_workers;
+
+    // survives reloads, i.e. the session ticket keys
+    std::shared_ptr<SSLServerState> state;
+
+    mutable std::mutex mutex;
+    std::shared_ptr<ssl_ctx_st> ctx;
+
+    int watch_fd{-1};
+    // watched file names per watched directory
+    std::map<int, std::vector<std::string>> watched_files;
+};
+
 // forward declaration
 struct SSLContext;
 class ConnectionSSL : public IConnection {
 public:
-    ConnectionSSL(PollManager&, const std::string& interface_name, const config::SSLConfig&);
+    // NOTE: uses the current setup of the server context, fails if there is none. The context is meant to be shared by
+    // all connections, loading it is expensive.
+    ConnectionSSL(PollManager&, const std::string& interface_name, const SSLServerContext&);
 
     void set_event_callback(const ConnectionEventCallback&) final;
     Ipv6EndPoint get_public_endpoint() const final;
@@ -25,22 +94,60 @@ public:
     ReadResult read(uint8_t* buf, size_t len) final;
 
     void close() final;
+    void linger_and_close(uint32_t linger_ms) final;
 
     std::optional<sha512_hash_t> get_vehicle_cert_hash() const final;
 
+    OutputQueueStats get_output_queue_stats() const final {
+        return output_queue.get_stats();
+    }
+
     ~ConnectionSSL();
 
 private:
     PollManager& poll_manager;
     std::unique_ptr<SSLContext> ssl;
 
+    std::shared_ptr<WorkerPool> handshake_workers;
+
     Ipv6EndPoint end_point;
 
     ConnectionEventCallback event_callback{nullptr};
 
+    OutputQueue output_queue;
+
     bool handshake_complete{false};
 
+    enum class CloseState {
+        NONE,
+        LINGER,
+        WAIT_FOR_FIN,
+        CLOSED,
+    };
+
+    CloseState close_state{CloseState::NONE};
+    bool peer_closed{false};
+    std::optional<TimerId> close_timer{std::nullopt};
+
+    // runs a poll callback, an error only tears down this connection and not the event loop shared with other sessions
+    void run_guarded(void (ConnectionSSL::*handler)());
+
     void handle_connect();
     void handle_data();
+
+    // runs the next handshake step within the handshake workers, the socket is not polled meanwhile
+    void start_handshake_job();
+    void handle_handshake_job_done();
+    // waits for a running handshake step and releases its eventfd
+    void release_handshake_job();
+    void finish_handshake();
+
+    void handle_writable();
+    // returns false, if the connection broke
+    bool flush_output_queue();
+
+    void handle_closing_data();
+    void shutdown_connection();
+    void finish_close();
 };
 } // namespace iso15118::io
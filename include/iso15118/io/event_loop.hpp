@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <iso15118/io/poll_manager.hpp>
+
+namespace iso15118::io {
+
+// Poll manager together with the thread running it. Tasks can be posted from any thread, they run within the thread of
+// the loop, so everything registered at the poll manager is only touched by a single thread.
+class EventLoop {
+public:
+    // loop running within the thread calling run(), shares the poll manager with the other users of that thread
+    explicit EventLoop(PollManager&);
+    // loop with its own poll manager, meant to be run by its own worker thread (see start())
+    EventLoop();
+    // NOTE: stops the worker thread
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    PollManager& get_poll_manager() {
+        return poll_manager;
+    }
+
+    // NOTE: can be called from any thread, the tasks run within the next wakeup of the loop in the order they have
+    // been posted
+    void post(std::function<void()> task);
+
+    // polls until stop() gets called or polling fails, before_poll runs ahead of every poll
+    void run(const std::function<void()>& before_poll);
+    // runs the loop within a new worker thread
+    void start(std::function<void()> before_poll);
+    // NOTE: waits for the worker thread, so it must not be called from within it
+    void stop();
+
+    // true, once run() left because of an error. Nothing runs within the loop anymore then, so whatever it owned can
+    // be released from any thread.
+    bool has_failed() const {
+        return failed;
+    }
+
+private:
+    void run_tasks();
+
+    std::unique_ptr<PollManager> owned_poll_manager;
+    PollManager& poll_manager;
+
+    std::thread thread;
+    std::atomic_bool running{true};
+    std::atomic_bool failed{false};
+
+    std::mutex tasks_mutex;
+    std::vector<std::function<void()>> tasks;
+};
+
+} // namespace iso15118::io
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iso15118::io {
+
+struct OutputQueueStats {
+    size_t queued_bytes{0};      // currently waiting to be written
+    size_t max_queued_bytes{0};  // high water mark
+    uint32_t deferred_writes{0}; // writes, which could not be completed right away
+};
+
+// Keeps the bytes, which could not be written to the socket yet
+class OutputQueue {
+public:
+    void push(const uint8_t* buf, size_t len);
+    void consume(size_t len);
+
+    const uint8_t* data() const {
+        return buffer.data() + offset;
+    }
+
+    size_t size() const {
+        return buffer.size() - offset;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    const OutputQueueStats& get_stats() const {
+        return stats;
+    }
+
+private:
+    std::vector<uint8_t> buffer;
+    size_t offset{0};
+
+    OutputQueueStats stats;
+};
+
+} // namespace iso15118::io
@@ -2,35 +2,115 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <poll.h>
+
+#include <iso15118/io/time.hpp>
+
 namespace iso15118::io {
 
 using PollCallback = const std::function<void()>;
+using TimerCallback = std::function<void()>;
+using TimerId = uint64_t;
+
+enum class PollBackend {
+    POLL,
+    EPOLL,
+};
+
+// one per registered fd, the epoll user data points directly to it
+struct PollRegistration {
+    int fd;
+    std::function<void()> callback;
+    bool edge_triggered{false};
+    std::function<void()> write_callback{nullptr};
+    bool write_interest{false};
+    bool active{true};
+};
+
 struct PollSet {
     std::vector<struct pollfd> fds;
-    std::vector<PollCallback*> callbacks;
+    std::vector<PollRegistration*> registrations;
 };
 
 class PollManager {
 public:
-    PollManager();
+    // NOTE: falls back to the poll() backend, if epoll is not available
+    explicit PollManager(PollBackend backend = PollBackend::EPOLL);
+    ~PollManager();
+
+    PollManager(const PollManager&) = delete;
+    PollManager& operator=(const PollManager&) = delete;
 
-    void register_fd(int fd, PollCallback& poll_callback);
+    // NOTE: edge triggered registrations are only honored by the epoll backend, the callback then needs to
+    // drain the fd until it would block
+    void register_fd(int fd, PollCallback& poll_callback, bool edge_triggered = false);
     void unregister_fd(int fd);
 
+    // NOTE: the write callback gets called on every wakeup the fd is writable, as long as the write interest is set.
+    // The write callback must not be replaced from within itself.
+    void set_write_callback(int fd, PollCallback& write_callback);
+    void set_write_interest(int fd, bool enabled);
+
+    // NOTE: timers are one-shot and backed by a single timerfd, which is always armed to the earliest deadline
+    TimerId schedule_timer(const TimePoint& deadline, TimerCallback callback);
+    // NOTE: cancelling an already expired or unknown timer is a no-op
+    void cancel_timer(TimerId id);
+
     void poll(int timeout_ms);
+    // NOTE: makes poll() return as soon as possible, pending fd events might not be dispatched
     void abort();
 
+    // NOTE: can be called from any thread, the notify callback then runs within poll() like any other fd callback.
+    // Several notifications before the next wakeup are coalesced into a single call.
+    void notify();
+    void set_notify_callback(PollCallback& notify_callback);
+
+    PollBackend get_backend() const {
+        return backend;
+    }
+
 private:
-    std::map<int, PollCallback> registered_fds;
+    void retire(std::unique_ptr<PollRegistration>);
+    void update_epoll_events(PollRegistration&);
+
+    void poll_with_poll(int timeout_ms);
+    void poll_with_epoll(int timeout_ms);
+
+    void handle_timer_fd();
+    void arm_timer_fd();
+
+    void handle_notify_fd();
 
+    PollBackend backend;
+
+    std::unordered_map<int, std::unique_ptr<PollRegistration>> registered_fds;
+
+    // registrations removed during dispatch, they get deleted after all callbacks of the current wakeup ran
+    std::vector<std::unique_ptr<PollRegistration>> retired_registrations;
+
+    // poll() backend only, rebuilt lazily on the next poll after the registrations changed
     PollSet poll_set;
+    bool poll_set_dirty{true};
+
+    // ordered by deadline, the id keeps timers with the same deadline apart
+    std::map<std::pair<TimePoint, TimerId>, TimerCallback> timers;
+    std::unordered_map<TimerId, TimePoint> timer_deadlines;
+    TimerId next_timer_id{1};
+
+    std::function<void()> notify_callback{nullptr};
 
+    int epoll_fd{-1};
     int event_fd{-1};
+    int timer_fd{-1};
+    int notify_fd{-1};
 };
 
 } // namespace iso15118::io
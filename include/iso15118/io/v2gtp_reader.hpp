@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "connection_abstract.hpp"
+#include "sdp.hpp"
+#include "sdp_packet.hpp"
+#include "stream_view.hpp"
+
+namespace iso15118::io {
+
+struct V2gtpFrame {
+    v2gtp::PayloadType payload_type;
+    StreamInputView payload;
+};
+
+// Receive buffer, which reads as much as available with a single read and parses all complete V2GTP frames in place.
+// NOTE: this is a linear buffer, which gets compacted before reading, so that a frame is always contiguous
+class V2gtpReader {
+public:
+    static constexpr size_t MAX_FRAME_SIZE = 2048; // including SdpPacket::V2GTP_HEADER_SIZE
+    static constexpr size_t BUFFER_SIZE = 2 * MAX_FRAME_SIZE;
+
+    enum class State {
+        OK,
+
+        // failed states
+        INVALID_HEADER,
+        PAYLOAD_TO_LONG,
+    };
+
+    // returns true, if the connection would block
+    bool fill(IConnection& connection);
+
+    // NOTE: the payload view is only valid until the next call to fill()
+    std::optional<V2gtpFrame> next_frame();
+
+    auto get_state() const {
+        return state;
+    }
+
+    size_t get_buffered_bytes() const {
+        return end - begin;
+    }
+
+private:
+    void compact();
+
+    State state{State::OK};
+    uint8_t buffer[BUFFER_SIZE];
+    size_t begin{0};
+    size_t end{0};
+};
+
+} // namespace iso15118::io
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iso15118::io {
+
+// Threads for expensive work, that should not block the event loops (i.e. the crypto of the TLS handshakes). The tasks
+// are started in the order they have been posted.
+class WorkerPool {
+public:
+    explicit WorkerPool(std::size_t thread_count);
+    // NOTE: waits for all posted tasks
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // NOTE: the future rethrows, if the task threw
+    std::future<void> post(std::function<void()> task);
+
+    std::size_t get_thread_count() const {
+        return threads.size();
+    }
+
+private:
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::packaged_task<void()>> tasks;
+    bool running{true};
+
+    std::vector<std::thread> threads;
+};
+
+} // namespace iso15118::io
@@ -7,6 +7,9 @@
 
 #include "common_types.hpp"
 
+// forward declare, defined by cbv2g
+struct iso20_ac_AC_ChargeLoopReqType;
+
 namespace iso15118::message_20 {
 
 namespace datatypes {
@@ -119,4 +122,33 @@ struct AC_ChargeLoopResponse {
         control_mode = datatypes::Scheduled_AC_CLResControlMode();
 };
 
+// Read-only access to an AC_ChargeLoopReq, either straight from the decoded exi document or from an already converted
+// AC_ChargeLoopRequest. The exi document belongs to the codec context, so a view on it is only valid until the context
+// is used for the next message, i.e. for encoding the response.
+class AC_ChargeLoopRequestView {
+public:
+    using Message = AC_ChargeLoopRequest;
+    using ControlMode = decltype(AC_ChargeLoopRequest::control_mode);
+
+    explicit AC_ChargeLoopRequestView(const AC_ChargeLoopRequest&);
+    explicit AC_ChargeLoopRequestView(const iso20_ac_AC_ChargeLoopReqType&);
+
+    Header get_header() const;
+    // NOTE: only copies the session id, the rest of the header is not converted
+    datatypes::SessionId get_session_id() const;
+    std::optional<datatypes::DisplayParameters> get_display_parameters() const;
+    bool get_meter_info_requested() const;
+
+    template <typename ControlModeType> bool holds_control_mode() const;
+    // NOTE: only the control mode gets converted
+    ControlMode get_control_mode() const;
+
+    // converts the whole request, i.e. to keep it beyond the lifetime of the exi document
+    Message get_message() const;
+
+private:
+    const AC_ChargeLoopRequest* message{nullptr};
+    const iso20_ac_AC_ChargeLoopReqType* document{nullptr};
+};
+
 } // namespace iso15118::message_20
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <memory>
+
+namespace iso15118::message_20 {
+
+// Owns the exi documents used for decoding and encoding messages. These are several kilobytes large, so a session
+// keeps one context instead of putting a fresh document on the stack for every message.
+class CodecContext {
+public:
+    // defined in iso15118/detail/codec_context.hpp
+    struct Documents;
+
+    CodecContext();
+    ~CodecContext();
+
+    CodecContext(const CodecContext&) = delete;
+    CodecContext& operator=(const CodecContext&) = delete;
+
+    Documents& get_documents() {
+        return *documents;
+    }
+
+private:
+    std::unique_ptr<Documents> documents;
+};
+
+} // namespace iso15118::message_20
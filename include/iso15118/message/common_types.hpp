@@ -3,6 +3,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -354,8 +355,13 @@ struct ContractCertificateChain {
 };
 
 float from_RationalNumber(const RationalNumber& in);
+// NOTE: the value is rounded to 4 significant digits, so it always fits into the int16 range
 RationalNumber from_float(float in);
 
+// batch versions of the above, i.e. for whole limit structs
+void from_RationalNumber(const RationalNumber* in, float* out, std::size_t count);
+void from_float(const float* in, RationalNumber* out, std::size_t count);
+
 std::string from_Protocol(const Protocol& in);
 
 std::string from_control_mode(const ControlMode& in);
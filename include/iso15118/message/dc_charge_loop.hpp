@@ -7,6 +7,9 @@
 
 #include "common_types.hpp"
 
+// forward declare, defined by cbv2g
+struct iso20_dc_DC_ChargeLoopReqType;
+
 namespace iso15118::message_20 {
 
 namespace datatypes {
@@ -107,4 +110,34 @@ struct DC_ChargeLoopResponse {
         control_mode = datatypes::Scheduled_DC_CLResControlMode();
 };
 
+// Read-only access to a DC_ChargeLoopReq, either straight from the decoded exi document or from an already converted
+// DC_ChargeLoopRequest. The exi document belongs to the codec context, so a view on it is only valid until the context
+// is used for the next message, i.e. for encoding the response.
+class DC_ChargeLoopRequestView {
+public:
+    using Message = DC_ChargeLoopRequest;
+    using ControlMode = decltype(DC_ChargeLoopRequest::control_mode);
+
+    explicit DC_ChargeLoopRequestView(const DC_ChargeLoopRequest&);
+    explicit DC_ChargeLoopRequestView(const iso20_dc_DC_ChargeLoopReqType&);
+
+    Header get_header() const;
+    // NOTE: only copies the session id, the rest of the header is not converted
+    datatypes::SessionId get_session_id() const;
+    std::optional<datatypes::DisplayParameters> get_display_parameters() const;
+    bool get_meter_info_requested() const;
+    datatypes::RationalNumber get_present_voltage() const;
+
+    template <typename ControlModeType> bool holds_control_mode() const;
+    // NOTE: only the control mode gets converted
+    ControlMode get_control_mode() const;
+
+    // converts the whole request, i.e. to keep it beyond the lifetime of the exi document
+    Message get_message() const;
+
+private:
+    const DC_ChargeLoopRequest* message{nullptr};
+    const iso20_dc_DC_ChargeLoopReqType* document{nullptr};
+};
+
 } // namespace iso15118::message_20
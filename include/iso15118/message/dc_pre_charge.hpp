@@ -4,6 +4,9 @@
 
 #include "common_types.hpp"
 
+// forward declare, defined by cbv2g
+struct iso20_dc_DC_PreChargeReqType;
+
 namespace iso15118::message_20 {
 
 struct DC_PreChargeRequest {
@@ -21,4 +24,26 @@ struct DC_PreChargeResponse {
     datatypes::RationalNumber present_voltage;
 };
 
+// Read-only access to a DC_PreChargeReq, either straight from the decoded exi document or from an already converted
+// DC_PreChargeRequest. The exi document belongs to the codec context, so a view on it is only valid until the context
+// is used for the next message, i.e. for encoding the response.
+class DC_PreChargeRequestView {
+public:
+    using Message = DC_PreChargeRequest;
+
+    explicit DC_PreChargeRequestView(const DC_PreChargeRequest&);
+    explicit DC_PreChargeRequestView(const iso20_dc_DC_PreChargeReqType&);
+
+    Header get_header() const;
+    // NOTE: only copies the session id, the rest of the header is not converted
+    datatypes::SessionId get_session_id() const;
+    datatypes::Processing get_processing() const;
+    datatypes::RationalNumber get_present_voltage() const;
+    datatypes::RationalNumber get_target_voltage() const;
+
+private:
+    const DC_PreChargeRequest* message{nullptr};
+    const iso20_dc_DC_PreChargeReqType* document{nullptr};
+};
+
 } // namespace iso15118::message_20
@@ -2,9 +2,8 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
-// FIXME (aw): how to streamline this with type.hpp?
-
 #include <iso15118/io/sdp.hpp>
+#include <iso15118/message/registry.hpp>
 
 namespace iso15118::message_20 {
 
@@ -17,29 +16,17 @@ template <typename T> struct PayloadTypeTrait;
 #define CREATE_TYPE_TRAIT_PUSHED CREATE_TYPE_TRAIT
 #endif
 
-#define CREATE_TYPE_TRAIT(struct_name, payload_type)                                                                   \
-    struct struct_name;                                                                                                \
-    template <> struct PayloadTypeTrait<struct_name> {                                                                 \
+#define CREATE_TYPE_TRAIT(name, payload_type, ...)                                                                     \
+    struct name##Request;                                                                                              \
+    struct name##Response;                                                                                             \
+    template <> struct PayloadTypeTrait<name##Request> {                                                               \
+        static const io::v2gtp::PayloadType type = io::v2gtp::PayloadType::payload_type;                               \
+    };                                                                                                                 \
+    template <> struct PayloadTypeTrait<name##Response> {                                                              \
         static const io::v2gtp::PayloadType type = io::v2gtp::PayloadType::payload_type;                               \
-    }
-
-CREATE_TYPE_TRAIT(SupportedAppProtocolResponse, SAP);
-CREATE_TYPE_TRAIT(SessionSetupResponse, Part20Main);
-CREATE_TYPE_TRAIT(AuthorizationSetupResponse, Part20Main);
-CREATE_TYPE_TRAIT(AuthorizationResponse, Part20Main);
-CREATE_TYPE_TRAIT(ServiceDiscoveryResponse, Part20Main);
-CREATE_TYPE_TRAIT(ServiceDetailResponse, Part20Main);
-CREATE_TYPE_TRAIT(ServiceSelectionResponse, Part20Main);
-CREATE_TYPE_TRAIT(DC_ChargeParameterDiscoveryResponse, Part20DC);
-CREATE_TYPE_TRAIT(ScheduleExchangeResponse, Part20Main);
-CREATE_TYPE_TRAIT(DC_CableCheckResponse, Part20DC);
-CREATE_TYPE_TRAIT(DC_PreChargeResponse, Part20DC);
-CREATE_TYPE_TRAIT(PowerDeliveryResponse, Part20Main);
-CREATE_TYPE_TRAIT(DC_ChargeLoopResponse, Part20DC);
-CREATE_TYPE_TRAIT(DC_WeldingDetectionResponse, Part20DC);
-CREATE_TYPE_TRAIT(SessionStopResponse, Part20Main);
-CREATE_TYPE_TRAIT(AC_ChargeParameterDiscoveryResponse, Part20AC);
-CREATE_TYPE_TRAIT(AC_ChargeLoopResponse, Part20AC);
+    };
+
+FOR_EACH_MESSAGE_20(CREATE_TYPE_TRAIT)
 
 #ifdef CREATE_TYPE_TRAIT_PUSHED
 #define CREATE_TYPE_TRAIT CREATE_TYPE_TRAIT_PUSHED
@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <iso15118/io/sdp.hpp>
+#include <iso15118/io/stream_view.hpp>
+
+#include "type.hpp"
+
+namespace iso15118::message_20 {
+
+// Returns the message type by only reading the event code of the document root, the body is not decoded. Returns
+// Type::None, if the payload is not recognized, a full decode is needed to tell more in that case.
+Type peek_type(io::v2gtp::PayloadType, const io::StreamInputView&);
+
+} // namespace iso15118::message_20
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+// Single description of all request/response pairs. The message type enum, the type traits, the event code tables of
+// peek_type(), the decoder dispatch and the sequence error responses are all generated from it, so adding a message
+// here updates every one of them.
+//
+// X(name, payload_type, document, field, event_code)
+//   name:         common prefix of the messages, i.e. SessionSetup for SessionSetupRequest/SessionSetupResponse and
+//                 Type::SessionSetupReq/Type::SessionSetupRes
+//   payload_type: io::v2gtp::PayloadType of the pair
+//   document:     member of CodecContext::Documents, that holds the messages
+//   field:        common prefix of the message members of the cbv2g exi document
+//   event_code:   event code of the request as document root, the one of the response always follows it
+//
+// NOTE: the order defines the enumerators of message_20::Type
+#define FOR_EACH_MESSAGE_20(X)                                                                                         \
+    X(SupportedAppProtocol, SAP, app_hand, supportedAppProtocol, 0)                                                    \
+    X(SessionSetup, Part20Main, main, SessionSetup, 35)                                                                \
+    X(AuthorizationSetup, Part20Main, main, AuthorizationSetup, 2)                                                     \
+    X(Authorization, Part20Main, main, Authorization, 0)                                                               \
+    X(ServiceDiscovery, Part20Main, main, ServiceDiscovery, 31)                                                        \
+    X(ServiceDetail, Part20Main, main, ServiceDetail, 29)                                                              \
+    X(ServiceSelection, Part20Main, main, ServiceSelection, 33)                                                        \
+    X(DC_ChargeParameterDiscovery, Part20DC, dc, DC_ChargeParameterDiscovery, 15)                                      \
+    X(ScheduleExchange, Part20Main, main, ScheduleExchange, 27)                                                        \
+    X(DC_CableCheck, Part20DC, dc, DC_CableCheck, 11)                                                                  \
+    X(DC_PreCharge, Part20DC, dc, DC_PreCharge, 17)                                                                    \
+    X(PowerDelivery, Part20Main, main, PowerDelivery, 21)                                                              \
+    X(DC_ChargeLoop, Part20DC, dc, DC_ChargeLoop, 13)                                                                  \
+    X(DC_WeldingDetection, Part20DC, dc, DC_WeldingDetection, 19)                                                      \
+    X(SessionStop, Part20Main, main, SessionStop, 37)                                                                  \
+    X(AC_ChargeParameterDiscovery, Part20AC, ac, AC_ChargeParameterDiscovery, 4)                                       \
+    X(AC_ChargeLoop, Part20AC, ac, AC_ChargeLoop, 2)
@@ -2,55 +2,75 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
+#include <cstddef>
+#include <stdexcept>
+
 #include <iso15118/io/stream_view.hpp>
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/registry.hpp>
 
 namespace iso15118::message_20 {
 
+#define CREATE_TYPE_ENUMERATORS(name, ...) name##Req, name##Res,
+
 enum class Type {
     None,
-    SupportedAppProtocolReq,
-    SupportedAppProtocolRes,
-    SessionSetupReq,
-    SessionSetupRes,
-    AuthorizationSetupReq,
-    AuthorizationSetupRes,
-    AuthorizationReq,
-    AuthorizationRes,
-    ServiceDiscoveryReq,
-    ServiceDiscoveryRes,
-    ServiceDetailReq,
-    ServiceDetailRes,
-    ServiceSelectionReq,
-    ServiceSelectionRes,
-    DC_ChargeParameterDiscoveryReq,
-    DC_ChargeParameterDiscoveryRes,
-    ScheduleExchangeReq,
-    ScheduleExchangeRes,
-    DC_CableCheckReq,
-    DC_CableCheckRes,
-    DC_PreChargeReq,
-    DC_PreChargeRes,
-    PowerDeliveryReq,
-    PowerDeliveryRes,
-    DC_ChargeLoopReq,
-    DC_ChargeLoopRes,
-    DC_WeldingDetectionReq,
-    DC_WeldingDetectionRes,
-    SessionStopReq,
-    SessionStopRes,
-    AC_ChargeParameterDiscoveryReq,
-    AC_ChargeParameterDiscoveryRes,
-    AC_ChargeLoopReq,
-    AC_ChargeLoopRes,
+    FOR_EACH_MESSAGE_20(CREATE_TYPE_ENUMERATORS)
 };
 
+#undef CREATE_TYPE_ENUMERATORS
+
+#define COUNT_TYPES(...) +2
+
+// number of enumerators of Type, including Type::None
+inline constexpr std::size_t TYPE_COUNT = 1 FOR_EACH_MESSAGE_20(COUNT_TYPES);
+
+#undef COUNT_TYPES
+
+constexpr std::size_t to_index(Type type) {
+    return static_cast<std::size_t>(type);
+}
+
+#define CREATE_TYPE_NAMES(name, ...)                                                                                   \
+    case Type::name##Req:                                                                                              \
+        return #name "Req";                                                                                            \
+    case Type::name##Res:                                                                                              \
+        return #name "Res";
+
+constexpr const char* to_string(Type type) {
+    switch (type) {
+        FOR_EACH_MESSAGE_20(CREATE_TYPE_NAMES)
+    case Type::None:
+        break;
+    }
+
+    return "None";
+}
+
+#undef CREATE_TYPE_NAMES
+
 template <typename T> struct TypeTrait {
     static const Type type = Type::None;
 };
 
+// the response message type of a request
+template <typename RequestType> struct ResponseTrait;
+
 template <typename InType, typename OutType> void convert(const InType&, OutType&);
 
-template <typename MessageType> size_t serialize(const MessageType&, const io::StreamOutputView&);
+// thrown by serialize(), if the encoded message doesn't fit into the output view
+class EncodingBufferOverflow : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+template <typename MessageType> size_t serialize(const MessageType&, const io::StreamOutputView&, CodecContext&);
+
+// NOTE: uses a temporary codec context, the overload above should be preferred for repeated calls
+template <typename MessageType> size_t serialize(const MessageType& msg, const io::StreamOutputView& out) {
+    CodecContext codec;
+    return serialize(msg, out, codec);
+}
 
 //
 // definitions of type traits
@@ -59,46 +79,20 @@ template <typename MessageType> size_t serialize(const MessageType&, const io::S
 #define CREATE_TYPE_TRAIT_PUSHED CREATE_TYPE_TRAIT
 #endif
 
-#define CREATE_TYPE_TRAIT(struct_name, enum_name)                                                                      \
-    struct struct_name;                                                                                                \
-    template <> struct TypeTrait<struct_name> {                                                                        \
-        static const Type type = Type::enum_name;                                                                      \
-    }
+#define CREATE_TYPE_TRAIT(name, ...)                                                                                   \
+    struct name##Request;                                                                                              \
+    struct name##Response;                                                                                             \
+    template <> struct TypeTrait<name##Request> {                                                                      \
+        static const Type type = Type::name##Req;                                                                      \
+    };                                                                                                                 \
+    template <> struct TypeTrait<name##Response> {                                                                     \
+        static const Type type = Type::name##Res;                                                                      \
+    };                                                                                                                 \
+    template <> struct ResponseTrait<name##Request> {                                                                  \
+        using type = name##Response;                                                                                   \
+    };
 
-CREATE_TYPE_TRAIT(SupportedAppProtocolRequest, SupportedAppProtocolReq);
-CREATE_TYPE_TRAIT(SupportedAppProtocolResponse, SupportedAppProtocolRes);
-CREATE_TYPE_TRAIT(SessionSetupRequest, SessionSetupReq);
-CREATE_TYPE_TRAIT(SessionSetupResponse, SessionSetupRes);
-CREATE_TYPE_TRAIT(AuthorizationSetupRequest, AuthorizationSetupReq);
-CREATE_TYPE_TRAIT(AuthorizationSetupResponse, AuthorizationSetupRes);
-CREATE_TYPE_TRAIT(AuthorizationRequest, AuthorizationReq);
-CREATE_TYPE_TRAIT(AuthorizationResponse, AuthorizationRes);
-CREATE_TYPE_TRAIT(ServiceDiscoveryRequest, ServiceDiscoveryReq);
-CREATE_TYPE_TRAIT(ServiceDiscoveryResponse, ServiceDiscoveryRes);
-CREATE_TYPE_TRAIT(ServiceDetailRequest, ServiceDetailReq);
-CREATE_TYPE_TRAIT(ServiceDetailResponse, ServiceDetailRes);
-CREATE_TYPE_TRAIT(ServiceSelectionRequest, ServiceSelectionReq);
-CREATE_TYPE_TRAIT(ServiceSelectionResponse, ServiceSelectionRes);
-CREATE_TYPE_TRAIT(DC_ChargeParameterDiscoveryRequest, DC_ChargeParameterDiscoveryReq);
-CREATE_TYPE_TRAIT(DC_ChargeParameterDiscoveryResponse, DC_ChargeParameterDiscoveryRes);
-CREATE_TYPE_TRAIT(ScheduleExchangeRequest, ScheduleExchangeReq);
-CREATE_TYPE_TRAIT(ScheduleExchangeResponse, ScheduleExchangeRes);
-CREATE_TYPE_TRAIT(DC_CableCheckRequest, DC_CableCheckReq);
-CREATE_TYPE_TRAIT(DC_CableCheckResponse, DC_CableCheckRes);
-CREATE_TYPE_TRAIT(DC_PreChargeRequest, DC_PreChargeReq);
-CREATE_TYPE_TRAIT(DC_PreChargeResponse, DC_PreChargeRes);
-CREATE_TYPE_TRAIT(PowerDeliveryRequest, PowerDeliveryReq);
-CREATE_TYPE_TRAIT(PowerDeliveryResponse, PowerDeliveryRes);
-CREATE_TYPE_TRAIT(DC_ChargeLoopRequest, DC_ChargeLoopReq);
-CREATE_TYPE_TRAIT(DC_ChargeLoopResponse, DC_ChargeLoopRes);
-CREATE_TYPE_TRAIT(DC_WeldingDetectionRequest, DC_WeldingDetectionReq);
-CREATE_TYPE_TRAIT(DC_WeldingDetectionResponse, DC_WeldingDetectionRes);
-CREATE_TYPE_TRAIT(SessionStopRequest, SessionStopReq);
-CREATE_TYPE_TRAIT(SessionStopResponse, SessionStopRes);
-CREATE_TYPE_TRAIT(AC_ChargeParameterDiscoveryRequest, AC_ChargeParameterDiscoveryReq);
-CREATE_TYPE_TRAIT(AC_ChargeParameterDiscoveryResponse, AC_ChargeParameterDiscoveryRes);
-CREATE_TYPE_TRAIT(AC_ChargeLoopRequest, AC_ChargeLoopReq);
-CREATE_TYPE_TRAIT(AC_ChargeLoopResponse, AC_ChargeLoopRes);
+FOR_EACH_MESSAGE_20(CREATE_TYPE_TRAIT)
 
 #ifdef CREATE_TYPE_TRAIT_PUSHED
 #define CREATE_TYPE_TRAIT CREATE_TYPE_TRAIT_PUSHED
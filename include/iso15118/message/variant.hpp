@@ -5,38 +5,72 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <new>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 // FIXME (aw): we only need the payload types from sdp.hpp, this could be shared in a separate header file
 #include <iso15118/io/sdp.hpp>
 #include <iso15118/io/stream_view.hpp>
 
+#include "codec_context.hpp"
 #include "type.hpp"
 
 namespace iso15118::message_20 {
 
+struct VariantAccess;
+
 class Variant {
 public:
+    // NOTE: messages up to this size are stored in place, only larger ones (i.e. ScheduleExchangeRes) get allocated
+    static constexpr std::size_t INPLACE_STORAGE_SIZE = 384;
+
+    // true, if the message gets stored in place
+    template <typename MessageType>
+    static constexpr bool stores_inplace =
+        sizeof(MessageType) <= INPLACE_STORAGE_SIZE and alignof(MessageType) <= alignof(std::max_align_t);
+
     using CustomDeleter = void (*)(void*);
+
+    Variant() = default;
+    // NOTE: uses a temporary codec context
     Variant(io::v2gtp::PayloadType, const io::StreamInputView&);
     template <typename MessageType> Variant(const MessageType& in) {
-        static_assert(TypeTrait<MessageType>::type != Type::None, "Unhandled type!");
-
-        data = new MessageType;
-        *static_cast<MessageType*>(data) = in;
-        custom_deleter = [](void* ptr) { delete static_cast<MessageType*>(ptr); };
-        type = message_20::TypeTrait<MessageType>::type;
+        emplace(in);
     }
     ~Variant();
 
+    Variant(const Variant&) = delete;
+    Variant& operator=(const Variant&) = delete;
+
+    // decodes a new message, replacing the current one and reusing its storage
+    void decode(io::v2gtp::PayloadType, const io::StreamInputView&, CodecContext&);
+
+    // NOTE: only peeks the message type, the message itself gets decoded on the first get() or get_if() of that
+    // type. Until then, the payload and the codec context need to stay valid.
+    void defer_decode(io::v2gtp::PayloadType, const io::StreamInputView&, CodecContext&);
+    // drops a pending decode, i.e. before the payload gets overwritten. Only the type stays available then.
+    void discard_pending_decode();
+
+    template <typename MessageType> void emplace(MessageType&& in) {
+        using Message = std::decay_t<MessageType>;
+        static_assert(TypeTrait<Message>::type != Type::None, "Unhandled type!");
+
+        create<Message>() = std::forward<MessageType>(in);
+    }
+
+    void reset();
+
     Type get_type() const;
 
     const std::string& get_error() const;
 
     template <typename T> const T& get() const {
         static_assert(TypeTrait<T>::type != Type::None, "Unhandled type!");
-        if (TypeTrait<T>::type != type) {
+        if (not is_decoded<T>()) {
             throw std::runtime_error("Illegal message type access");
         }
 
@@ -45,17 +79,68 @@ public:
 
     template <typename T> T const* get_if() const {
         static_assert(TypeTrait<T>::type != Type::None, "Unhandled type!");
-        if (TypeTrait<T>::type != type) {
+        if (not is_decoded<T>()) {
             return nullptr;
         }
 
         return static_cast<T*>(data);
     }
 
+    // NOTE: for a pending decode, only the exi document gets decoded and the view refers to it. This consumes the
+    // pending decode, so the message can't be accessed by another get_view(), get() or get_if() afterwards. Otherwise
+    // the view refers to the converted message. Available for DC_ChargeLoopRequestView, AC_ChargeLoopRequestView and
+    // DC_PreChargeRequestView.
+    template <typename ViewType> std::optional<ViewType> get_view() const;
+
 private:
+    friend struct VariantAccess;
+
+    struct PendingDecode {
+        io::v2gtp::PayloadType payload_type;
+        io::StreamInputView payload;
+        CodecContext* codec;
+    };
+
+    template <typename T> bool is_decoded() const {
+        if (TypeTrait<T>::type != type) {
+            return false;
+        }
+
+        if (pending_decode) {
+            // NOTE: variants are never const objects, only the access to them is
+            const_cast<Variant*>(this)->decode_pending();
+            // the peeked type might have been wrong or the decoding failed
+            return TypeTrait<T>::type == type;
+        }
+
+        // the pending decode might have been consumed by a view or discarded
+        return data != nullptr;
+    }
+
+    void decode_pending();
+
+    template <typename MessageType> MessageType& create() {
+        reset();
+
+        if constexpr (stores_inplace<MessageType>) {
+            data = new (storage) MessageType;
+            custom_deleter = [](void* ptr) { static_cast<MessageType*>(ptr)->~MessageType(); };
+        } else {
+            data = new MessageType;
+            custom_deleter = [](void* ptr) { delete static_cast<MessageType*>(ptr); };
+        }
+        type = TypeTrait<MessageType>::type;
+
+        return *static_cast<MessageType*>(data);
+    }
+
     CustomDeleter custom_deleter{nullptr};
     void* data{nullptr};
     Type type{Type::None};
     std::string error;
+
+    std::optional<PendingDecode> pending_decode{std::nullopt};
+
+    alignas(std::max_align_t) uint8_t storage[INPLACE_STORAGE_SIZE];
 };
 } // namespace iso15118::message_20
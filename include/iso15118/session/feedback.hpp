@@ -113,6 +113,14 @@ public:
     void selected_vas_services(const dt::VasSelectedServiceList&) const;
     void ac_limits(const feedback::AcLimits&) const;
 
+    // allow skipping the conversion of the request values, if nobody listens to them
+    bool has_dc_charge_loop_req() const {
+        return static_cast<bool>(callbacks.dc_charge_loop_req);
+    }
+    bool has_ac_charge_loop_req() const {
+        return static_cast<bool>(callbacks.ac_charge_loop_req);
+    }
+
 private:
     feedback::Callbacks callbacks;
 };
@@ -2,8 +2,10 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
+#include <array>
 #include <memory>
 #include <optional>
+#include <variant>
 
 #include <iso15118/config.hpp>
 
@@ -17,6 +19,7 @@
 #include <iso15118/io/poll_manager.hpp>
 #include <iso15118/io/sdp_packet.hpp>
 #include <iso15118/io/time.hpp>
+#include <iso15118/io/v2gtp_reader.hpp>
 
 #include <iso15118/session/feedback.hpp>
 #include <iso15118/session/logger.hpp>
@@ -29,6 +32,8 @@ struct SessionState {
     bool connected{false};
     bool new_data{false};
     bool fsm_needs_call{false};
+    bool closing{false};
+    bool closed{false};
 };
 
 class Session {
@@ -40,29 +45,39 @@ public:
     TimePoint const& poll();
     void push_control_event(const d20::ControlEvent&);
 
+    // NOTE: a stopped or paused session is finished, once its connection is torn down
     bool is_finished() const {
-        return (ctx.session_stopped or ctx.session_paused);
+        return state.closed;
     }
 
     void close();
 
+    io::OutputQueueStats get_output_queue_stats() const {
+        return connection->get_output_queue_stats();
+    }
+
+    const d20::EncodedSizeStatistics& get_encoded_size_stats() const {
+        return message_exchange.get_encoded_size_stats();
+    }
+
 private:
     std::unique_ptr<io::IConnection> connection;
     session::SessionLogger log;
 
     SessionState state;
     // input buffer
-    io::SdpPacket packet;
+    io::V2gtpReader reader;
 
-    // output buffer
-    uint8_t response_buffer[1028];
+    // output buffers
+    d20::OutputBufferPool output_buffers{io::SdpPacket::V2GTP_HEADER_SIZE};
 
-    d20::MessageExchange message_exchange{{response_buffer + io::SdpPacket::V2GTP_HEADER_SIZE,
-                                           sizeof(response_buffer) - io::SdpPacket::V2GTP_HEADER_SIZE}};
+    d20::MessageExchange message_exchange{output_buffers};
 
     // control event buffer
     d20::ControlEventQueue control_event_queue;
     std::optional<d20::ControlEvent> active_control_event{std::nullopt};
+    // newest state like event per type, only used with SessionConfig::coalesce_control_events
+    std::array<std::optional<d20::ControlEvent>, std::variant_size_v<d20::ControlEvent>> coalesced_control_events;
 
     d20::Context ctx;
 
@@ -72,6 +87,12 @@ private:
 
     d20::Timeouts timeouts;
 
+    void handle_frame(const io::V2gtpFrame&);
+    void send_pending_response();
+
+    void handle_control_events();
+    void handle_active_control_event();
+
     void handle_connection_event(io::ConnectionEvent event);
 };
 
@@ -4,14 +4,18 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include "config.hpp"
+#include "connector_table.hpp"
 #include <iso15118/d20/config.hpp>
 #include <iso15118/d20/control_event.hpp>
 #include <iso15118/d20/limits.hpp>
+#include <iso15118/d20/response_template_cache.hpp>
+#include <iso15118/io/connection_ssl.hpp>
 #include <iso15118/io/poll_manager.hpp>
 #include <iso15118/io/sdp_server.hpp>
 #include <iso15118/message/common_types.hpp>
@@ -25,42 +29,110 @@ struct TbdConfig {
     std::string interface_name;
     config::TlsNegotiationStrategy tls_negotiation_strategy{config::TlsNegotiationStrategy::ACCEPT_CLIENT_OFFER};
     bool enable_sdp_server{true};
+    // Number of worker threads, each running its own event loop with a subset of the sessions. With 0, everything
+    // runs within the thread calling loop().
+    size_t worker_threads{0};
+};
+
+// Per connector setup, the interface_name is also used as the key for routing control events and updates
+struct TbdConnectorConfig {
+    std::string interface_name;
+    d20::EvseSetupConfig evse_setup;
+    session::feedback::Callbacks callbacks;
 };
 
 class TbdController {
 public:
     TbdController(TbdConfig, session::feedback::Callbacks, d20::EvseSetupConfig);
+    // NOTE: TbdConfig::interface_name is not used here, every connector brings its own interface
+    TbdController(TbdConfig, std::vector<TbdConnectorConfig>);
+    ~TbdController();
 
     void loop();
 
+    // NOTE: the overloads without a connector name are routed to the first configured connector. All of them can be
+    // called from any thread, they are handed over to the thread owning the session.
     void send_control_event(const d20::ControlEvent&);
+    void send_control_event(const std::string& connector, const d20::ControlEvent&);
 
     void update_authorization_services(const std::vector<message_20::datatypes::Authorization>& services,
                                        bool cert_install_service);
+    void update_authorization_services(const std::string& connector,
+                                       const std::vector<message_20::datatypes::Authorization>& services,
+                                       bool cert_install_service);
     void update_dc_limits(const d20::DcTransferLimits&);
+    void update_dc_limits(const std::string& connector, const d20::DcTransferLimits&);
     void update_powersupply_limits(const d20::DcTransferLimits&);
+    void update_powersupply_limits(const std::string& connector, const d20::DcTransferLimits&);
     void update_energy_modes(const std::vector<message_20::datatypes::ServiceCategory>&);
+    void update_energy_modes(const std::string& connector, const std::vector<message_20::datatypes::ServiceCategory>&);
     void update_ac_limits(const d20::AcTransferLimits&);
+    void update_ac_limits(const std::string& connector, const d20::AcTransferLimits&);
 
     void update_supported_vas_services(const std::vector<uint16_t>& vas_services);
+    void update_supported_vas_services(const std::string& connector, const std::vector<uint16_t>& vas_services);
+
+    // rebuilds the TLS server setup from the certificate files, ongoing sessions are not affected. Changes of the files
+    // are picked up automatically, this is only needed if they can't be watched. Returns false, if loading failed and
+    // the previous setup is still in use.
+    bool reload_certificates();
+
+    // NOTE: all zero, if tls is disabled
+    io::TlsHandshakeStats get_tls_handshake_stats() const;
 
 private:
+    // one event loop together with the sessions it owns
+    struct Shard;
+
+    struct Connector {
+        // resolved interface name (might differ from the key, i.e. "auto")
+        std::string interface_name;
+
+        std::unique_ptr<io::SdpServer> sdp_server;
+        std::unique_ptr<Session> session;
+
+        session::feedback::Callbacks callbacks;
+
+        d20::EvseSetupConfig evse_setup;
+        // encoded responses for the current evse_setup, gets replaced whenever the services change
+        std::shared_ptr<d20::ResponseTemplateCache> response_templates{std::make_shared<d20::ResponseTemplateCache>()};
+
+        std::optional<d20::PauseContext> pause_ctx{std::nullopt};
+
+        // protects evse_setup, response_templates and shard, the session itself is only touched by the thread of its
+        // shard
+        std::mutex mutex;
+        Shard* shard{nullptr};
+    };
+
     io::PollManager poll_manager;
-    std::unique_ptr<io::SdpServer> sdp_server;
 
-    std::unique_ptr<Session> session;
+    // shared by all tls connections, nullptr if tls is disabled
+    std::unique_ptr<io::SSLServerContext> ssl_server_context;
 
-    // callbacks for sdp server
-    void handle_sdp_server_input();
+    // NOTE: declared before the connectors, because the sessions need to be destroyed before their poll managers
+    std::vector<std::unique_ptr<Shard>> shards;
 
-    const TbdConfig config;
-    const session::feedback::Callbacks callbacks;
+    ConnectorTable<Connector> connectors;
 
-    d20::EvseSetupConfig evse_setup;
+    void add_connector(TbdConnectorConfig);
+    // NOTE: needs to be called with the mutex of the connector locked
+    static d20::SessionConfig create_session_config(const Connector&);
+    // NOTE: failed shards are skipped, nullptr if none is left
+    Shard* get_least_loaded_shard();
+    void assign_plain_session(Connector&);
+    void start_plain_session(Shard&, Connector&);
+    std::unique_ptr<io::IConnection> create_connection(io::PollManager&, const Connector&, bool secure_connection);
 
-    std::string interface_name;
+    // polls the sessions of the shard and schedules its wakeup for the next session deadline
+    void prepare_shard_wakeup(Shard&);
+    TimePoint poll_sessions(Shard&);
+    void stop_shards();
 
-    std::optional<d20::PauseContext> pause_ctx{std::nullopt};
+    // callbacks for sdp server
+    void handle_sdp_server_input(Connector&);
+
+    const TbdConfig config;
 };
 
 } // namespace iso15118
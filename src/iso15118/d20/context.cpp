@@ -13,24 +13,52 @@ std::unique_ptr<MessageExchange> create_message_exchange(uint8_t* buf, const siz
     return std::make_unique<MessageExchange>(std::move(view));
 }
 
-MessageExchange::MessageExchange(io::StreamOutputView output_) : response(std::move(output_)) {
+MessageExchange::MessageExchange(io::StreamOutputView output_, ResponseRetention retention_) :
+    response(std::move(output_)), retention(retention_) {
 }
 
-void MessageExchange::set_request(std::unique_ptr<message_20::Variant> new_request) {
-    if (request) {
+MessageExchange::MessageExchange(OutputBufferPool& output_buffers_, ResponseRetention retention_) :
+    output_buffers(&output_buffers_), response(output_buffers_.get_payload_view(0)), retention(retention_) {
+}
+
+bool MessageExchange::select_output_buffer(size_t size_class) {
+    if (output_buffers == nullptr) {
+        return size_class == 0;
+    }
+
+    if (size_class >= OutputBufferPool::SIZE_CLASS_COUNT) {
+        return false;
+    }
+
+    if (size_class != response_size_class) {
+        response = output_buffers->get_payload_view(size_class);
+        response_size_class = size_class;
+    }
+
+    return true;
+}
+
+void MessageExchange::check_request_handled() const {
+    if (request_available) {
         // FIXME (aw): we might want to have a stack here?
         throw std::runtime_error("Previous V2G message has not been handled yet");
     }
+}
 
-    request = std::move(new_request);
+void MessageExchange::set_request(io::v2gtp::PayloadType payload_type, const io::StreamInputView& payload) {
+    check_request_handled();
+
+    request.defer_decode(payload_type, payload, codec);
+    request_available = true;
 }
 
-std::unique_ptr<message_20::Variant> MessageExchange::pull_request() {
-    if (not request) {
+const message_20::Variant* MessageExchange::pull_request() {
+    if (not request_available) {
         throw std::runtime_error("Tried to access V2G message, but there is none");
     }
 
-    return std::move(request);
+    request_available = false;
+    return &request;
 }
 
 std::tuple<bool, size_t, io::v2gtp::PayloadType, message_20::Type> MessageExchange::check_and_clear_response() {
@@ -43,12 +71,16 @@ std::tuple<bool, size_t, io::v2gtp::PayloadType, message_20::Type> MessageExchan
     return retval;
 }
 
+void MessageExchange::release_request_payload() {
+    request.discard_pending_decode();
+}
+
 message_20::Type MessageExchange::peek_request_type() const {
-    if (not request) {
+    if (not request_available) {
         logf_warning("Tried to access V2G message, but there is none");
         return message_20::Type::None;
     }
-    return request->get_type();
+    return request.get_type();
 }
 
 Context::Context(session::feedback::Callbacks feedback_callbacks, session::SessionLogger& logger,
@@ -64,7 +96,7 @@ Context::Context(session::feedback::Callbacks feedback_callbacks, session::Sessi
     timeouts(timeouts_) {
 }
 
-std::unique_ptr<message_20::Variant> Context::pull_request() {
+const message_20::Variant* Context::pull_request() {
     return message_exchange.pull_request();
 }
 
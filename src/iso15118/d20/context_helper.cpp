@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
+#include <array>
 #include <ctime>
 
 #include <iso15118/detail/d20/context_helper.hpp>
@@ -14,12 +15,14 @@
 #include <iso15118/message/dc_pre_charge.hpp>
 #include <iso15118/message/dc_welding_detection.hpp>
 #include <iso15118/message/power_delivery.hpp>
+#include <iso15118/message/registry.hpp>
 #include <iso15118/message/schedule_exchange.hpp>
 #include <iso15118/message/service_detail.hpp>
 #include <iso15118/message/service_discovery.hpp>
 #include <iso15118/message/service_selection.hpp>
 #include <iso15118/message/session_setup.hpp>
 #include <iso15118/message/session_stop.hpp>
+#include <iso15118/message/supported_app_protocol.hpp>
 
 namespace iso15118::d20 {
 
@@ -46,60 +49,47 @@ template <typename Response> Response handle_sequence_error(const d20::Session&
     return response_with_code(res, message_20::datatypes::ResponseCode::FAILED_SequenceError);
 }
 
-// Todo(sl): Not happy at all. Need refactoring. Only ctx.respond and Session is needed. Not the whole Context.
-void send_sequence_error(const message_20::Type req_type, d20::Context& ctx) {
+static void log_unknown_type(const message_20::Type req_type, d20::Context&) {
+    logf_warning("Unknown code type id: %d ", req_type);
+}
 
-    if (req_type == message_20::Type::SessionSetupReq) {
-        const auto res = handle_sequence_error<message_20::SessionSetupResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::AuthorizationSetupReq) {
-        const auto res = handle_sequence_error<message_20::AuthorizationSetupResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::AuthorizationReq) {
-        const auto res = handle_sequence_error<message_20::AuthorizationResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::ServiceDiscoveryReq) {
-        const auto res = handle_sequence_error<message_20::ServiceDiscoveryResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::ServiceDetailReq) {
-        const auto res = handle_sequence_error<message_20::ServiceDetailResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::ServiceSelectionReq) {
-        const auto res = handle_sequence_error<message_20::ServiceSelectionResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::AC_ChargeParameterDiscoveryReq) {
-        const auto res = handle_sequence_error<message_20::AC_ChargeParameterDiscoveryResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::DC_ChargeParameterDiscoveryReq) {
-        const auto res = handle_sequence_error<message_20::DC_ChargeParameterDiscoveryResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::ScheduleExchangeReq) {
-        const auto res = handle_sequence_error<message_20::ScheduleExchangeResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::DC_CableCheckReq) {
-        const auto res = handle_sequence_error<message_20::DC_CableCheckResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::PowerDeliveryReq) {
-        const auto res = handle_sequence_error<message_20::PowerDeliveryResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::DC_PreChargeReq) {
-        const auto res = handle_sequence_error<message_20::DC_PreChargeResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::DC_ChargeLoopReq) {
-        const auto res = handle_sequence_error<message_20::DC_ChargeLoopResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::AC_ChargeLoopReq) {
-        const auto res = handle_sequence_error<message_20::AC_ChargeLoopResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::DC_WeldingDetectionReq) {
-        const auto res = handle_sequence_error<message_20::DC_WeldingDetectionResponse>(ctx.session);
-        ctx.respond(res);
-    } else if (req_type == message_20::Type::SessionStopReq) {
-        const auto res = handle_sequence_error<message_20::SessionStopResponse>(ctx.session);
-        ctx.respond(res);
+template <typename Response>
+static void send_sequence_error_response(const message_20::Type req_type, d20::Context& ctx) {
+    if constexpr (message_20::PayloadTypeTrait<Response>::type == io::v2gtp::PayloadType::SAP) {
+        // the supported app protocol response has no header and is not sent by the d20 states
+        log_unknown_type(req_type, ctx);
     } else {
-        logf_warning("Unknown code type id: %d ", req_type);
+        const auto res = handle_sequence_error<Response>(ctx.session);
+        ctx.respond(res);
+    }
+}
+
+using SequenceErrorFunction = void (*)(const message_20::Type, d20::Context&);
+
+#define ADD_SEQUENCE_ERROR_FUNCTION(name, ...)                                                                         \
+    table[message_20::to_index(message_20::Type::name##Req)] =                                                         \
+        send_sequence_error_response<message_20::ResponseTrait<message_20::name##Request>::type>;
+
+static constexpr std::array<SequenceErrorFunction, message_20::TYPE_COUNT> create_sequence_error_functions() {
+    std::array<SequenceErrorFunction, message_20::TYPE_COUNT> table{};
+
+    for (auto& function : table) {
+        function = log_unknown_type;
     }
+
+    FOR_EACH_MESSAGE_20(ADD_SEQUENCE_ERROR_FUNCTION)
+
+    return table;
+}
+
+#undef ADD_SEQUENCE_ERROR_FUNCTION
+
+// indexed by the request type
+static constexpr auto SEQUENCE_ERROR_FUNCTIONS = create_sequence_error_functions();
+
+// Todo(sl): Not happy at all. Need refactoring. Only ctx.respond and Session is needed. Not the whole Context.
+void send_sequence_error(const message_20::Type req_type, d20::Context& ctx) {
+    SEQUENCE_ERROR_FUNCTIONS[message_20::to_index(req_type)](req_type, ctx);
 }
 
 } // namespace iso15118::d20
@@ -2,25 +2,144 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <iso15118/d20/control_event_queue.hpp>
 
+#include <type_traits>
+
 namespace iso15118::d20 {
 
+// The ring follows the bounded queue by Dmitry Vyukov: every slot carries a sequence number, which tells producers and
+// the consumer whether the slot is free for the current lap or holds an event for it.
+struct ControlEventQueue::Slot {
+    std::atomic<std::size_t> sequence{0};
+    std::optional<Entry> entry{std::nullopt};
+};
+
+static std::size_t round_up_to_power_of_two(std::size_t value) {
+    std::size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+ControlEventQueue::ControlEventQueue(std::size_t capacity, ControlEventOverflowPolicy overflow_policy_) :
+    mask(round_up_to_power_of_two(capacity) - 1), overflow_policy(overflow_policy_) {
+    slots = std::make_unique<Slot[]>(mask + 1);
+    for (std::size_t i = 0; i <= mask; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+ControlEventQueue::~ControlEventQueue() = default;
+
+bool ControlEventQueue::try_push(Entry& entry) {
+    auto pos = enqueue_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+        auto& slot = slots[pos & mask];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::make_signed_t<std::size_t>>(sequence - pos);
+
+        if (diff == 0) {
+            // slot is free, try to claim it
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.entry.emplace(std::move(entry));
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // slot still holds the event of the previous lap, queue is full
+            return false;
+        } else {
+            // another producer was faster
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::optional<ControlEventQueue::Entry> ControlEventQueue::pop_state_event() {
+    auto pos = dequeue_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+        auto& slot = slots[pos & mask];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::make_signed_t<std::size_t>>(sequence - (pos + 1));
+
+        if (diff == 0) {
+            // NOTE: the consumer needs to claim the slot as well, producers overwriting the oldest event compete here
+            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                auto entry = std::move(slot.entry);
+                slot.entry.reset();
+                slot.sequence.store(pos + mask + 1, std::memory_order_release);
+                return entry;
+            }
+        } else if (diff < 0) {
+            // empty
+            return std::nullopt;
+        } else {
+            pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
 std::optional<ControlEvent> ControlEventQueue::pop() {
-    std::lock_guard<std::mutex> lck(mutex);
+    if (not pending_state_event) {
+        pending_state_event = pop_state_event();
+    }
 
-    if (queue.empty()) {
-        return std::nullopt;
+    if (edge_event_count.load(std::memory_order_acquire) != 0) {
+        if (not pending_state_event) {
+            // a state event pushed ahead of the edge event might have become visible only after the first look at
+            // the ring, it needs to be popped first
+            pending_state_event = pop_state_event();
+        }
+
+        std::scoped_lock lock(edge_events_mutex);
+
+        if (not edge_events.empty() and
+            (not pending_state_event or edge_events.front().first < pending_state_event->first)) {
+            auto event = std::move(edge_events.front().second);
+            edge_events.pop_front();
+            edge_event_count.fetch_sub(1, std::memory_order_release);
+            return event;
+        }
     }
 
-    auto event = std::make_optional<ControlEvent>(std::move(queue.front()));
-    queue.pop();
+    if (not pending_state_event) {
+        return std::nullopt;
+    }
 
+    auto event = std::move(pending_state_event->second);
+    pending_state_event.reset();
     return event;
 }
 
-void ControlEventQueue::push(ControlEvent event) {
-    std::lock_guard<std::mutex> lck(mutex);
+bool ControlEventQueue::push(ControlEvent event) {
+    const auto is_state_event = is_state_control_event(event);
+    Entry entry{push_order.fetch_add(1, std::memory_order_relaxed), std::move(event)};
+
+    if (not is_state_event) {
+        std::scoped_lock lock(edge_events_mutex);
+        edge_events.push_back(std::move(entry));
+        edge_event_count.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    bool lossless = true;
+
+    while (not try_push(entry)) {
+        if (overflow_policy == ControlEventOverflowPolicy::DROP_NEWEST) {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // make room by discarding the oldest state event, the consumer might have been faster though
+        if (pop_state_event()) {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            lossless = false;
+        }
+    }
 
-    queue.push(std::move(event));
+    return lossless;
 }
 
 } // namespace iso15118::d20
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/d20/limits.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace iso15118::d20 {
+
+namespace {
+
+// collects the values of a limit struct, so they can be converted in one batch
+class BatchConversion {
+public:
+    void add(float in, dt::RationalNumber& out) {
+        values[size] = in;
+        outputs[size] = &out;
+        ++size;
+    }
+
+    void add(const Limit<float>& in, Limit<dt::RationalNumber>& out) {
+        add(in.max, out.max);
+        add(in.min, out.min);
+    }
+
+    template <typename InType, typename OutType>
+    void add(const std::optional<InType>& in, std::optional<OutType>& out) {
+        if (in.has_value()) {
+            add(*in, out.emplace());
+        } else {
+            out.reset();
+        }
+    }
+
+    void run() {
+        dt::from_float(values.data(), results.data(), size);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            *outputs[i] = results[i];
+        }
+    }
+
+private:
+    // the ac transfer limits with all optional values set are the largest struct
+    static constexpr std::size_t MAX_VALUES = 15;
+
+    std::array<float, MAX_VALUES> values;
+    std::array<dt::RationalNumber, MAX_VALUES> results;
+    std::array<dt::RationalNumber*, MAX_VALUES> outputs;
+    std::size_t size{0};
+};
+
+} // namespace
+
+DcTransferLimits convert_limits(const DcTransferLimitValues& in) {
+    DcTransferLimits out;
+    BatchConversion batch;
+
+    batch.add(in.charge_limits.power, out.charge_limits.power);
+    batch.add(in.charge_limits.current, out.charge_limits.current);
+
+    if (in.discharge_limits.has_value()) {
+        auto& discharge_limits = out.discharge_limits.emplace();
+        batch.add(in.discharge_limits->power, discharge_limits.power);
+        batch.add(in.discharge_limits->current, discharge_limits.current);
+    }
+
+    batch.add(in.voltage, out.voltage);
+    batch.add(in.power_ramp_limit, out.power_ramp_limit);
+
+    batch.run();
+
+    return out;
+}
+
+AcTransferLimits convert_limits(const AcTransferLimitValues& in) {
+    AcTransferLimits out;
+    BatchConversion batch;
+
+    batch.add(in.charge_power, out.charge_power);
+    batch.add(in.charge_power_L2, out.charge_power_L2);
+    batch.add(in.charge_power_L3, out.charge_power_L3);
+
+    batch.add(in.nominal_frequency, out.nominal_frequency);
+    batch.add(in.max_power_asymmetry, out.max_power_asymmetry);
+    batch.add(in.power_ramp_limitation, out.power_ramp_limitation);
+
+    batch.add(in.discharge_power, out.discharge_power);
+    batch.add(in.discharge_power_L2, out.discharge_power_L2);
+    batch.add(in.discharge_power_L3, out.discharge_power_L3);
+
+    batch.run();
+
+    return out;
+}
+
+} // namespace iso15118::d20
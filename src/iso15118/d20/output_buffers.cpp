@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/d20/output_buffers.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace iso15118::d20 {
+
+OutputBufferPool::OutputBufferPool(std::size_t header_size_) : header_size(header_size_) {
+    if (header_size >= SIZE_CLASSES.front()) {
+        throw std::invalid_argument("Output buffer header does not fit into the smallest size class");
+    }
+
+    // the smallest buffer is used for every response
+    buffers.front() = std::make_unique<uint8_t[]>(SIZE_CLASSES.front());
+}
+
+io::StreamOutputView OutputBufferPool::get_payload_view(std::size_t size_class) {
+    if (size_class >= SIZE_CLASS_COUNT) {
+        throw std::out_of_range("Invalid output buffer size class");
+    }
+
+    auto& buffer = buffers[size_class];
+    if (not buffer) {
+        buffer = std::make_unique<uint8_t[]>(SIZE_CLASSES[size_class]);
+    }
+
+    return {buffer.get() + header_size, SIZE_CLASSES[size_class] - header_size};
+}
+
+void EncodedSizeStatistics::add(message_20::Type type, std::size_t size, std::size_t size_class) {
+    auto& entry = stats[message_20::to_index(type)];
+
+    entry.count++;
+    entry.max_size = std::max(entry.max_size, size);
+    entry.total_size += size;
+    entry.size_class_counts[std::min(size_class, OutputBufferPool::SIZE_CLASS_COUNT - 1)]++;
+}
+
+} // namespace iso15118::d20
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/d20/response_template_cache.hpp>
+
+#include <array>
+#include <cstring>
+
+#include <iso15118/detail/helper.hpp>
+
+namespace iso15118::d20 {
+
+namespace {
+
+constexpr std::size_t SESSION_ID_BITS = message_20::datatypes::SESSION_ID_LENGTH * 8;
+
+// unsigned integers are encoded in EXI as little endian 7 bit groups, the msb of each byte tells if another follows
+constexpr std::size_t MAX_UINT_64_SIZE = 10;
+
+std::size_t encode_exi_uint(uint64_t value, std::array<uint8_t, MAX_UINT_64_SIZE>& out) {
+    std::size_t size = 0;
+    do {
+        out[size] = value & 0x7f;
+        value >>= 7;
+        if (value != 0) {
+            out[size] |= 0x80;
+        }
+        ++size;
+    } while (value != 0);
+
+    return size;
+}
+
+bool get_bit(const uint8_t* buffer, std::size_t position) {
+    return (buffer[position / 8] >> (7 - position % 8)) & 1;
+}
+
+void set_bit(uint8_t* buffer, std::size_t position, bool value) {
+    const uint8_t mask = 1 << (7 - position % 8);
+    if (value) {
+        buffer[position / 8] |= mask;
+    } else {
+        buffer[position / 8] &= ~mask;
+    }
+}
+
+// NOTE: the fields of the header are not byte aligned within the stream
+void write_bits(uint8_t* buffer, std::size_t position, const uint8_t* data, std::size_t data_size) {
+    for (std::size_t i = 0; i < data_size * 8; ++i) {
+        set_bit(buffer, position + i, get_bit(data, i));
+    }
+}
+
+bool compare_bits(const uint8_t* buffer, std::size_t position, const uint8_t* data, std::size_t data_size) {
+    for (std::size_t i = 0; i < data_size * 8; ++i) {
+        if (get_bit(buffer, position + i) != get_bit(data, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::size_t ResponseTemplateCache::size() const {
+    std::scoped_lock lock(mutex);
+    return templates.size();
+}
+
+std::size_t ResponseTemplateCache::apply(message_20::Type type, uint32_t key, const message_20::Header* header,
+                                         const io::StreamOutputView& out) const {
+    std::scoped_lock lock(mutex);
+
+    const auto it = templates.find({type, key});
+    if (it == templates.end()) {
+        return 0;
+    }
+
+    const auto& entry = it->second;
+
+    if (entry.exi.size() > out.payload_len) {
+        return 0;
+    }
+
+    std::array<uint8_t, MAX_UINT_64_SIZE> timestamp;
+    if (header != nullptr and encode_exi_uint(header->timestamp, timestamp) != entry.timestamp_size) {
+        // the length of the encoded header differs, so the template doesn't fit
+        return 0;
+    }
+
+    std::memcpy(out.payload, entry.exi.data(), entry.exi.size());
+
+    if (header != nullptr) {
+        write_bits(out.payload, entry.session_id_bit_offset, header->session_id.data(), header->session_id.size());
+        write_bits(out.payload, entry.timestamp_bit_offset, timestamp.data(), entry.timestamp_size);
+    }
+
+    return entry.exi.size();
+}
+
+void ResponseTemplateCache::add(message_20::Type type, uint32_t key, const io::StreamInputView& exi,
+                                const std::vector<uint8_t>& probe_exi, const message_20::Header* header) {
+    Template entry{{exi.payload, exi.payload + exi.payload_len}, 0, 0, 0};
+
+    if (header != nullptr) {
+        const auto total_bits = exi.payload_len * 8;
+
+        std::vector<std::size_t> differing_bits;
+        for (std::size_t i = 0; i < total_bits; ++i) {
+            if (get_bit(exi.payload, i) != get_bit(probe_exi.data(), i)) {
+                differing_bits.push_back(i);
+            }
+        }
+
+        // all bits of the session id and the lowest bit of the timestamp are expected to differ
+        if (differing_bits.size() != SESSION_ID_BITS + 1) {
+            logf_warning("Unexpected header encoding, not caching the response template");
+            return;
+        }
+
+        std::array<uint8_t, MAX_UINT_64_SIZE> timestamp;
+        entry.session_id_bit_offset = differing_bits.front();
+        entry.timestamp_size = encode_exi_uint(header->timestamp, timestamp);
+
+        // the lowest bit of the timestamp is the last one of its first byte
+        const auto timestamp_lowest_bit = differing_bits.back();
+
+        if (differing_bits[SESSION_ID_BITS - 1] != entry.session_id_bit_offset + SESSION_ID_BITS - 1 or
+            timestamp_lowest_bit < 7 or timestamp_lowest_bit - 7 + entry.timestamp_size * 8 > total_bits or
+            not compare_bits(exi.payload, timestamp_lowest_bit - 7, timestamp.data(), entry.timestamp_size)) {
+            logf_warning("Unexpected header encoding, not caching the response template");
+            return;
+        }
+
+        entry.timestamp_bit_offset = timestamp_lowest_bit - 7;
+    }
+
+    std::scoped_lock lock(mutex);
+
+    if (templates.size() >= MAX_TEMPLATES) {
+        return;
+    }
+
+    templates.insert_or_assign({type, key}, std::move(entry));
+}
+
+} // namespace iso15118::d20
@@ -65,30 +65,89 @@ void convert(Dynamic_BPT_AC_Res& out, const AcTargetPower& targets, const d20::A
 
 // TODO(sl): Refactor with DcChargeLoop state
 namespace {
+template <typename T> void set_dynamic_parameters_in_res(T& res_mode, const UpdateDynamicModeParameters& parameters) {
+    res_mode.target_soc = parameters.target_soc;
+    res_mode.minimum_soc = parameters.min_soc;
+    res_mode.ack_max_delay = 30; // TODO(sl) what to send here and define 30 seconds as const
+}
+
+// NOTE: the departure time is relative to the header timestamp, so it can't be part of the cached control mode
 template <typename T>
-void set_dynamic_parameters_in_res(T& res_mode, const UpdateDynamicModeParameters& parameters,
-                                   uint64_t header_timestamp) {
+void set_departure_time_in_res(T& res_mode, const UpdateDynamicModeParameters& parameters, uint64_t header_timestamp) {
     if (parameters.departure_time) {
         const auto departure_time = static_cast<uint64_t>(parameters.departure_time.value());
         if (departure_time > header_timestamp) {
             res_mode.departure_time = static_cast<uint32_t>(departure_time - header_timestamp);
         }
     }
-    res_mode.target_soc = parameters.target_soc;
-    res_mode.minimum_soc = parameters.min_soc;
-    res_mode.ack_max_delay = 30; // TODO(sl) what to send here and define 30 seconds as const
 }
 } // namespace
 
+std::optional<AC_ControlModeResponse>
+create_control_mode_response(const SelectedServiceParameters& selected_services, const AcTargetPower& target_powers,
+                             const AcPresentPower& present_powers,
+                             const UpdateDynamicModeParameters& dynamic_parameters) {
+    const auto selected_control_mode = selected_services.selected_control_mode;
+    const auto selected_energy_service = selected_services.selected_energy_service;
+    const auto provided_by_secc =
+        selected_services.selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc;
+
+    AC_ControlModeResponse control_mode;
+
+    if (selected_control_mode == dt::ControlMode::Scheduled and selected_energy_service == dt::ServiceCategory::AC) {
+        convert(control_mode.emplace<Scheduled_AC_Res>(), target_powers, present_powers);
+    } else if (selected_control_mode == dt::ControlMode::Scheduled and
+               selected_energy_service == dt::ServiceCategory::AC_BPT) {
+        convert(control_mode.emplace<Scheduled_BPT_AC_Res>(), target_powers, present_powers);
+    } else if (selected_control_mode == dt::ControlMode::Dynamic and
+               selected_energy_service == dt::ServiceCategory::AC) {
+        auto& res_mode = control_mode.emplace<Dynamic_AC_Res>();
+        convert(res_mode, target_powers, present_powers);
+        if (provided_by_secc) {
+            set_dynamic_parameters_in_res(res_mode, dynamic_parameters);
+        }
+    } else if (selected_control_mode == dt::ControlMode::Dynamic and
+               selected_energy_service == dt::ServiceCategory::AC_BPT) {
+        auto& res_mode = control_mode.emplace<Dynamic_BPT_AC_Res>();
+        convert(res_mode, target_powers, present_powers);
+        if (provided_by_secc) {
+            set_dynamic_parameters_in_res(res_mode, dynamic_parameters);
+        }
+    } else {
+        return std::nullopt;
+    }
+
+    return control_mode;
+}
+
 message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoopRequest& req,
                                                  const d20::Session& session, bool stop, bool pause,
                                                  float target_frequency, const AcTargetPower& target_powers,
                                                  const AcPresentPower& present_powers,
                                                  const UpdateDynamicModeParameters& dynamic_parameters) {
+    return handle_request(message_20::AC_ChargeLoopRequestView(req), session, stop, pause, target_frequency,
+                          target_powers, present_powers, dynamic_parameters);
+}
+
+message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, bool stop, bool pause,
+                                                 float target_frequency, const AcTargetPower& target_powers,
+                                                 const AcPresentPower& present_powers,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters) {
+    const auto control_mode = create_control_mode_response(session.get_selected_services(), target_powers,
+                                                           present_powers, dynamic_parameters);
+    return handle_request(req, session, stop, pause, target_frequency, control_mode, dynamic_parameters);
+}
+
+message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, bool stop, bool pause,
+                                                 float target_frequency,
+                                                 const std::optional<AC_ControlModeResponse>& control_mode,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters) {
 
     message_20::AC_ChargeLoopResponse res;
 
-    if (validate_and_setup_header(res.header, session, req.header.session_id) == false) {
+    if (validate_and_setup_header(res.header, session, req.get_session_id()) == false) {
         return response_with_code(res, dt::ResponseCode::FAILED_UnknownSession);
     }
 
@@ -97,58 +156,39 @@ message_20::AC_ChargeLoopResponse handle_request(const message_20::AC_ChargeLoop
     const auto selected_energy_service = selected_services.selected_energy_service;
     const auto selected_mobility_needs_mode = selected_services.selected_mobility_needs_mode;
 
-    if (std::holds_alternative<Scheduled_AC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
+    // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
+    // the charger should terminate the session
+    if (req.holds_control_mode<Scheduled_AC_Req>()) {
         if (selected_control_mode != dt::ControlMode::Scheduled or selected_energy_service != dt::ServiceCategory::AC) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
-
-        auto& res_mode = res.control_mode.emplace<Scheduled_AC_Res>();
-        convert(res_mode, target_powers, present_powers);
-
-    } else if (std::holds_alternative<Scheduled_BPT_AC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
+    } else if (req.holds_control_mode<Scheduled_BPT_AC_Req>()) {
         if (selected_control_mode != dt::ControlMode::Scheduled or
             selected_energy_service != dt::ServiceCategory::AC_BPT) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
-
-        auto& res_mode = res.control_mode.emplace<Scheduled_BPT_AC_Res>();
-        convert(res_mode, target_powers, present_powers);
-
-    } else if (std::holds_alternative<Dynamic_AC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
+    } else if (req.holds_control_mode<Dynamic_AC_Req>()) {
         if (selected_control_mode != dt::ControlMode::Dynamic or selected_energy_service != dt::ServiceCategory::AC) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
-
-        auto& res_mode = res.control_mode.emplace<Dynamic_AC_Res>();
-        convert(res_mode, target_powers, present_powers);
-
-        if (selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc) {
-            set_dynamic_parameters_in_res(res_mode, dynamic_parameters, res.header.timestamp);
-        }
-
-    } else if (std::holds_alternative<Dynamic_BPT_AC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
+    } else if (req.holds_control_mode<Dynamic_BPT_AC_Req>()) {
         if (selected_control_mode != dt::ControlMode::Dynamic or
             selected_energy_service != dt::ServiceCategory::AC_BPT) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
+    }
 
-        auto& res_mode = res.control_mode.emplace<Dynamic_BPT_AC_Res>();
-        convert(res_mode, target_powers, present_powers);
+    if (not control_mode.has_value()) {
+        return response_with_code(res, dt::ResponseCode::FAILED);
+    }
+
+    res.control_mode = *control_mode;
 
-        if (selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc) {
-            set_dynamic_parameters_in_res(res_mode, dynamic_parameters, res.header.timestamp);
+    if (selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc) {
+        if (auto* res_mode = std::get_if<Dynamic_AC_Res>(&res.control_mode)) {
+            set_departure_time_in_res(*res_mode, dynamic_parameters, res.header.timestamp);
+        } else if (auto* res_mode = std::get_if<Dynamic_BPT_AC_Res>(&res.control_mode)) {
+            set_departure_time_in_res(*res_mode, dynamic_parameters, res.header.timestamp);
         }
     }
 
@@ -172,6 +212,7 @@ void AC_ChargeLoop::enter() {
     dynamic_parameters = m_ctx.cache_dynamic_mode_parameters.value_or(UpdateDynamicModeParameters{});
     target_powers = m_ctx.cache_ac_target_power.value_or(AcTargetPower{});
     present_powers = m_ctx.cache_ac_present_power.value_or(AcPresentPower{});
+    control_mode_response_outdated = true;
 }
 
 Result AC_ChargeLoop::feed(Event ev) {
@@ -183,10 +224,13 @@ Result AC_ChargeLoop::feed(Event ev) {
             pause = *control_data;
         } else if (const auto* control_data = m_ctx.get_control_event<UpdateDynamicModeParameters>()) {
             dynamic_parameters = *control_data;
+            control_mode_response_outdated = true;
         } else if (const auto* control_data = m_ctx.get_control_event<AcTargetPower>()) {
             target_powers = *control_data;
+            control_mode_response_outdated = true;
         } else if (const auto* control_data = m_ctx.get_control_event<AcPresentPower>()) {
             present_powers = *control_data;
+            control_mode_response_outdated = true;
         }
 
         // Ignore control message
@@ -217,14 +261,27 @@ Result AC_ChargeLoop::feed(Event ev) {
         }
 
         return {};
-    } else if (const auto req = variant->get_if<message_20::AC_ChargeLoopRequest>()) {
+    } else if (const auto req = variant->get_view<message_20::AC_ChargeLoopRequestView>()) {
         if (first_entry_in_charge_loop) {
             m_ctx.feedback.signal(session::feedback::Signal::CHARGE_LOOP_STARTED);
             first_entry_in_charge_loop = false;
         }
 
-        const auto res = handle_request(*req, m_ctx.session, stop, pause, target_frequency, target_powers,
-                                        present_powers, dynamic_parameters);
+        if (control_mode_response_outdated) {
+            control_mode_response = create_control_mode_response(m_ctx.session.get_selected_services(), target_powers,
+                                                                 present_powers, dynamic_parameters);
+            control_mode_response_outdated = false;
+        }
+
+        const auto res = handle_request(*req, m_ctx.session, stop, pause, target_frequency, control_mode_response,
+                                        dynamic_parameters);
+
+        // NOTE: the view might refer to the exi document, which gets reused for encoding the response. So the request
+        // values for the feedback are copied before, if anyone listens to them.
+        std::optional<message_20::AC_ChargeLoopRequest> feedback_req;
+        if (res.response_code < dt::ResponseCode::FAILED and m_ctx.feedback.has_ac_charge_loop_req()) {
+            feedback_req = req->get_message();
+        }
 
         m_ctx.respond(res);
 
@@ -233,10 +290,12 @@ Result AC_ChargeLoop::feed(Event ev) {
             return {};
         }
 
-        m_ctx.feedback.ac_charge_loop_req(req->control_mode);
-        m_ctx.feedback.ac_charge_loop_req(req->meter_info_requested);
-        if (req->display_parameters) {
-            m_ctx.feedback.ac_charge_loop_req(*req->display_parameters);
+        if (feedback_req) {
+            m_ctx.feedback.ac_charge_loop_req(feedback_req->control_mode);
+            m_ctx.feedback.ac_charge_loop_req(feedback_req->meter_info_requested);
+            if (feedback_req->display_parameters) {
+                m_ctx.feedback.ac_charge_loop_req(*feedback_req->display_parameters);
+            }
         }
 
         return {};
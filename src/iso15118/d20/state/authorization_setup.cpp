@@ -71,7 +71,13 @@ Result AuthorizationSetup::feed(Event ev) {
 
         logf_info("Timestamp: %d", req->header.timestamp);
 
-        m_ctx.respond(res);
+        // the pnc authorization mode contains a random challenge
+        if (res.response_code == dt::ResponseCode::OK and
+            std::holds_alternative<dt::EIM_ASResAuthorizationMode>(res.authorization_mode)) {
+            m_ctx.respond_from_template(res, 0);
+        } else {
+            m_ctx.respond(res);
+        }
 
         if (res.response_code >= dt::ResponseCode::FAILED) {
             m_ctx.session_stopped = true;
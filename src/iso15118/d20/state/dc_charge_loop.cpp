@@ -69,30 +69,98 @@ template <> void convert(Dynamic_BPT_DC_Res& out, const d20::DcTransferLimits& i
 }
 
 namespace {
+template <typename T> void set_dynamic_parameters_in_res(T& res_mode, const UpdateDynamicModeParameters& parameters) {
+    res_mode.target_soc = parameters.target_soc;
+    res_mode.minimum_soc = parameters.min_soc;
+    res_mode.ack_max_delay = 30; // TODO(sl) what to send here and define 30 seconds as const
+}
+
+// NOTE: the departure time is relative to the header timestamp, so it can't be part of the cached control mode
 template <typename T>
-void set_dynamic_parameters_in_res(T& res_mode, const UpdateDynamicModeParameters& parameters,
-                                   uint64_t header_timestamp) {
+void set_departure_time_in_res(T& res_mode, const UpdateDynamicModeParameters& parameters, uint64_t header_timestamp) {
     if (parameters.departure_time) {
         const auto departure_time = static_cast<uint64_t>(parameters.departure_time.value());
         if (departure_time > header_timestamp) {
             res_mode.departure_time = static_cast<uint32_t>(departure_time - header_timestamp);
         }
     }
-    res_mode.target_soc = parameters.target_soc;
-    res_mode.minimum_soc = parameters.min_soc;
-    res_mode.ack_max_delay = 30; // TODO(sl) what to send here and define 30 seconds as const
+}
+
+bool is_dc_service(dt::ServiceCategory service) {
+    return service == dt::ServiceCategory::DC or service == dt::ServiceCategory::MCS;
+}
+
+bool is_dc_bpt_service(dt::ServiceCategory service) {
+    return service == dt::ServiceCategory::DC_BPT or service == dt::ServiceCategory::MCS_BPT;
 }
 } // namespace
 
+std::optional<DC_ControlModeResponse>
+create_control_mode_response(const SelectedServiceParameters& selected_services, const DcTransferLimits& dc_limits,
+                             const UpdateDynamicModeParameters& dynamic_parameters) {
+    const auto selected_control_mode = selected_services.selected_control_mode;
+    const auto selected_energy_service = selected_services.selected_energy_service;
+    const auto provided_by_secc =
+        selected_services.selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc;
+
+    if (is_dc_bpt_service(selected_energy_service) and not dc_limits.discharge_limits.has_value()) {
+        return std::nullopt;
+    }
+
+    DC_ControlModeResponse control_mode;
+
+    if (selected_control_mode == dt::ControlMode::Scheduled and is_dc_service(selected_energy_service)) {
+        convert(control_mode.emplace<Scheduled_DC_Res>(), dc_limits);
+    } else if (selected_control_mode == dt::ControlMode::Scheduled and is_dc_bpt_service(selected_energy_service)) {
+        convert(control_mode.emplace<Scheduled_BPT_DC_Res>(), dc_limits);
+    } else if (selected_control_mode == dt::ControlMode::Dynamic and is_dc_service(selected_energy_service)) {
+        auto& res_mode = control_mode.emplace<Dynamic_DC_Res>();
+        convert(res_mode, dc_limits);
+        if (provided_by_secc) {
+            set_dynamic_parameters_in_res(res_mode, dynamic_parameters);
+        }
+    } else if (selected_control_mode == dt::ControlMode::Dynamic and is_dc_bpt_service(selected_energy_service)) {
+        auto& res_mode = control_mode.emplace<Dynamic_BPT_DC_Res>();
+        convert(res_mode, dc_limits);
+        if (provided_by_secc) {
+            set_dynamic_parameters_in_res(res_mode, dynamic_parameters);
+        }
+    } else {
+        return std::nullopt;
+    }
+
+    return control_mode;
+}
+
 message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoopRequest& req,
                                                  const d20::Session& session, const float present_voltage,
                                                  const float present_current, const bool stop, const bool pause,
                                                  const DcTransferLimits& dc_limits,
                                                  const UpdateDynamicModeParameters& dynamic_parameters) {
+    return handle_request(message_20::DC_ChargeLoopRequestView(req), session, present_voltage, present_current, stop,
+                          pause, dc_limits, dynamic_parameters);
+}
+
+message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, const float present_voltage,
+                                                 const float present_current, const bool stop, const bool pause,
+                                                 const DcTransferLimits& dc_limits,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters) {
+    const auto control_mode =
+        create_control_mode_response(session.get_selected_services(), dc_limits, dynamic_parameters);
+    return handle_request(req, session, present_voltage, present_current, stop, pause, control_mode,
+                         dynamic_parameters);
+}
+
+message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoopRequestView& req,
+                                                 const d20::Session& session, const float present_voltage,
+                                                 const float present_current, const bool stop, const bool pause,
+                                                 const std::optional<DC_ControlModeResponse>& control_mode,
+                                                 const UpdateDynamicModeParameters& dynamic_parameters) {
 
     message_20::DC_ChargeLoopResponse res;
 
-    if (validate_and_setup_header(res.header, session, req.header.session_id) == false) {
+    if (validate_and_setup_header(res.header, session, req.get_session_id()) == false) {
         return response_with_code(res, dt::ResponseCode::FAILED_UnknownSession);
     }
 
@@ -101,74 +169,39 @@ message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoop
     const auto selected_energy_service = selected_services.selected_energy_service;
     const auto selected_mobility_needs_mode = selected_services.selected_mobility_needs_mode;
 
-    if (std::holds_alternative<Scheduled_DC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
-        if (selected_control_mode != dt::ControlMode::Scheduled or
-            not(selected_energy_service == dt::ServiceCategory::DC or
-                selected_energy_service == dt::ServiceCategory::MCS)) {
-            return response_with_code(res, dt::ResponseCode::FAILED);
-        }
-
-        auto& res_mode = res.control_mode.emplace<Scheduled_DC_Res>();
-        convert(res_mode, dc_limits);
-
-    } else if (std::holds_alternative<Scheduled_BPT_DC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
-        if (selected_control_mode != dt::ControlMode::Scheduled or
-            not(selected_energy_service == dt::ServiceCategory::DC_BPT or
-                selected_energy_service == dt::ServiceCategory::MCS_BPT)) {
+    // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
+    // the charger should terminate the session
+    if (req.holds_control_mode<Scheduled_DC_Req>()) {
+        if (selected_control_mode != dt::ControlMode::Scheduled or not is_dc_service(selected_energy_service)) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
-
-        if (not dc_limits.discharge_limits.has_value()) {
-            logf_error("Transfer mode is BPT, but only dc limits without discharge limits are provided!");
+    } else if (req.holds_control_mode<Scheduled_BPT_DC_Req>()) {
+        if (selected_control_mode != dt::ControlMode::Scheduled or not is_dc_bpt_service(selected_energy_service)) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
-
-        auto& res_mode = res.control_mode.emplace<Scheduled_BPT_DC_Res>();
-        convert(res_mode, dc_limits);
-
-    } else if (std::holds_alternative<Dynamic_DC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
-        if (selected_control_mode != dt::ControlMode::Dynamic or
-            not(selected_energy_service == dt::ServiceCategory::DC or
-                selected_energy_service == dt::ServiceCategory::MCS)) {
+    } else if (req.holds_control_mode<Dynamic_DC_Req>()) {
+        if (selected_control_mode != dt::ControlMode::Dynamic or not is_dc_service(selected_energy_service)) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
-
-        auto& res_mode = res.control_mode.emplace<Dynamic_DC_Res>();
-        convert(res_mode, dc_limits);
-
-        if (selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc) {
-            set_dynamic_parameters_in_res(res_mode, dynamic_parameters, res.header.timestamp);
-        }
-
-    } else if (std::holds_alternative<Dynamic_BPT_DC_Req>(req.control_mode)) {
-
-        // If the ev sends a false control mode or a false energy service other than the previous selected ones, then
-        // the charger should terminate the session
-        if (selected_control_mode != dt::ControlMode::Dynamic or
-            not(selected_energy_service == dt::ServiceCategory::DC_BPT or
-                selected_energy_service == dt::ServiceCategory::MCS_BPT)) {
+    } else if (req.holds_control_mode<Dynamic_BPT_DC_Req>()) {
+        if (selected_control_mode != dt::ControlMode::Dynamic or not is_dc_bpt_service(selected_energy_service)) {
             return response_with_code(res, dt::ResponseCode::FAILED);
         }
+    }
 
-        if (not dc_limits.discharge_limits.has_value()) {
-            logf_error("Transfer mode is BPT, but only dc limits without discharge limits are provided!");
-            return response_with_code(res, dt::ResponseCode::FAILED);
-        }
+    // the control mode matches the selected services here, so only missing discharge limits leave it empty
+    if (not control_mode.has_value()) {
+        logf_error("Transfer mode is BPT, but only dc limits without discharge limits are provided!");
+        return response_with_code(res, dt::ResponseCode::FAILED);
+    }
 
-        auto& res_mode = res.control_mode.emplace<Dynamic_BPT_DC_Res>();
-        convert(res_mode, dc_limits);
+    res.control_mode = *control_mode;
 
-        if (selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc) {
-            set_dynamic_parameters_in_res(res_mode, dynamic_parameters, res.header.timestamp);
+    if (selected_mobility_needs_mode == dt::MobilityNeedsMode::ProvidedBySecc) {
+        if (auto* res_mode = std::get_if<Dynamic_DC_Res>(&res.control_mode)) {
+            set_departure_time_in_res(*res_mode, dynamic_parameters, res.header.timestamp);
+        } else if (auto* res_mode = std::get_if<Dynamic_BPT_DC_Res>(&res.control_mode)) {
+            set_departure_time_in_res(*res_mode, dynamic_parameters, res.header.timestamp);
         }
     }
 
@@ -191,6 +224,7 @@ message_20::DC_ChargeLoopResponse handle_request(const message_20::DC_ChargeLoop
 void DC_ChargeLoop::enter() {
     m_ctx.log.enter_state("DC_ChargeLoop");
     dynamic_parameters = m_ctx.cache_dynamic_mode_parameters.value_or(UpdateDynamicModeParameters{});
+    control_mode_response_outdated = true;
 }
 
 Result DC_ChargeLoop::feed(Event ev) {
@@ -206,6 +240,10 @@ Result DC_ChargeLoop::feed(Event ev) {
             pause = *control_data;
         } else if (const auto* control_data = m_ctx.get_control_event<UpdateDynamicModeParameters>()) {
             dynamic_parameters = *control_data;
+            control_mode_response_outdated = true;
+        } else if (m_ctx.get_control_event<DcTransferLimits>() != nullptr) {
+            // the session config already holds the new limits
+            control_mode_response_outdated = true;
         }
 
         // Ignore control message
@@ -240,14 +278,27 @@ Result DC_ChargeLoop::feed(Event ev) {
         }
 
         return {};
-    } else if (const auto req = variant->get_if<message_20::DC_ChargeLoopRequest>()) {
+    } else if (const auto req = variant->get_view<message_20::DC_ChargeLoopRequestView>()) {
         if (first_entry_in_charge_loop) {
             m_ctx.feedback.signal(session::feedback::Signal::CHARGE_LOOP_STARTED);
             first_entry_in_charge_loop = false;
         }
 
+        if (control_mode_response_outdated) {
+            control_mode_response = create_control_mode_response(m_ctx.session.get_selected_services(),
+                                                                 m_ctx.session_config.dc_limits, dynamic_parameters);
+            control_mode_response_outdated = false;
+        }
+
         const auto res = handle_request(*req, m_ctx.session, present_voltage, present_current, stop, pause,
-                                        m_ctx.session_config.dc_limits, dynamic_parameters);
+                                        control_mode_response, dynamic_parameters);
+
+        // NOTE: the view might refer to the exi document, which gets reused for encoding the response. So the request
+        // values for the feedback are copied before, if anyone listens to them.
+        std::optional<message_20::DC_ChargeLoopRequest> feedback_req;
+        if (res.response_code < dt::ResponseCode::FAILED and m_ctx.feedback.has_dc_charge_loop_req()) {
+            feedback_req = req->get_message();
+        }
 
         m_ctx.respond(res);
 
@@ -256,11 +307,13 @@ Result DC_ChargeLoop::feed(Event ev) {
             return {};
         }
 
-        m_ctx.feedback.dc_charge_loop_req(req->control_mode);
-        m_ctx.feedback.dc_charge_loop_req(req->present_voltage);
-        m_ctx.feedback.dc_charge_loop_req(req->meter_info_requested);
-        if (req->display_parameters) {
-            m_ctx.feedback.dc_charge_loop_req(*req->display_parameters);
+        if (feedback_req) {
+            m_ctx.feedback.dc_charge_loop_req(feedback_req->control_mode);
+            m_ctx.feedback.dc_charge_loop_req(feedback_req->present_voltage);
+            m_ctx.feedback.dc_charge_loop_req(feedback_req->meter_info_requested);
+            if (feedback_req->display_parameters) {
+                m_ctx.feedback.dc_charge_loop_req(*feedback_req->display_parameters);
+            }
         }
 
         return {};
@@ -14,10 +14,15 @@ namespace dt = message_20::datatypes;
 
 message_20::DC_PreChargeResponse handle_request(const message_20::DC_PreChargeRequest& req, const d20::Session& session,
                                                 const float present_voltage) {
+    return handle_request(message_20::DC_PreChargeRequestView(req), session, present_voltage);
+}
+
+message_20::DC_PreChargeResponse handle_request(const message_20::DC_PreChargeRequestView& req,
+                                                const d20::Session& session, const float present_voltage) {
 
     message_20::DC_PreChargeResponse res;
 
-    if (validate_and_setup_header(res.header, session, req.header.session_id) == false) {
+    if (validate_and_setup_header(res.header, session, req.get_session_id()) == false) {
         return response_with_code(res, dt::ResponseCode::FAILED_UnknownSession);
     }
 
@@ -50,14 +55,15 @@ Result DC_PreCharge::feed(Event ev) {
 
     const auto variant = m_ctx.pull_request();
 
-    if (const auto req = variant->get_if<message_20::DC_PreChargeRequest>()) {
+    if (const auto req = variant->get_view<message_20::DC_PreChargeRequestView>()) {
         if (not pre_charge_initiated) {
             m_ctx.feedback.signal(session::feedback::Signal::PRE_CHARGE_STARTED);
             pre_charge_initiated = true;
         }
         const auto res = handle_request(*req, m_ctx.session, present_voltage);
 
-        m_ctx.feedback.dc_pre_charge_target_voltage(message_20::datatypes::from_RationalNumber(req->target_voltage));
+        m_ctx.feedback.dc_pre_charge_target_voltage(
+            message_20::datatypes::from_RationalNumber(req->get_target_voltage()));
 
         m_ctx.respond(res);
 
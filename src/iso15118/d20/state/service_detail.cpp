@@ -202,7 +202,9 @@ Result ServiceDetail::feed(Event ev) {
 
         std::optional<dt::ServiceParameterList> custom_vas_parameters{std::nullopt};
 
-        if (not find_energy_services(energy_services, req->service)) {
+        const auto is_energy_service = find_energy_services(energy_services, req->service);
+
+        if (not is_energy_service) {
             logf_info("Getting vas (id: %u) parameters", req->service);
             custom_vas_parameters = m_ctx.feedback.get_vas_parameters(req->service);
 
@@ -225,7 +227,12 @@ Result ServiceDetail::feed(Event ev) {
 
         const auto res = handle_request(*req, m_ctx.session, m_ctx.session_config, custom_vas_parameters);
 
-        m_ctx.respond(res);
+        // the parameters of the vas services might change with every request
+        if (res.response_code == dt::ResponseCode::OK and is_energy_service) {
+            m_ctx.respond_from_template(res, req->service);
+        } else {
+            m_ctx.respond(res);
+        }
 
         if (res.response_code >= dt::ResponseCode::FAILED) {
             m_ctx.session_stopped = true;
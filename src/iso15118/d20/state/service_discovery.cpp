@@ -136,7 +136,12 @@ Result ServiceDiscovery::feed(Event ev) {
             handle_request(*req, m_ctx.session, m_ctx.session_config.supported_energy_transfer_services,
                            m_ctx.session_config.supported_vas_services, m_ctx.session_ev_info.ev_energy_services);
 
-        m_ctx.respond(res);
+        // without a filter of the ev, the offered services only depend on the session config
+        if (res.response_code == dt::ResponseCode::OK and not req->supported_service_ids.has_value()) {
+            m_ctx.respond_from_template(res, 0);
+        } else {
+            m_ctx.respond(res);
+        }
 
         if (res.response_code >= dt::ResponseCode::FAILED) {
             m_ctx.session_stopped = true;
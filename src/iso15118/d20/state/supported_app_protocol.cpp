@@ -57,7 +57,8 @@ Result SupportedAppProtocol::feed(Event ev) {
     if (const auto req = variant->get_if<message_20::SupportedAppProtocolRequest>()) {
 
         const auto res = handle_request(*req, m_ctx.session_config.custom_protocol);
-        m_ctx.respond(res);
+        // the response only consists of the response code and the schema id
+        m_ctx.respond_from_template(res, (static_cast<uint32_t>(res.response_code) << 8) | res.schema_id.value_or(0));
         m_ctx.ev_info.ev_supported_app_protocols = req->app_protocol;
 
         if (res.response_code == ResponseCode::Failed_NoNegotiation) {
@@ -54,4 +54,21 @@ std::optional<std::vector<TimeoutType>> Timeouts::check() {
     return std::nullopt;
 }
 
+std::optional<TimePoint> Timeouts::get_next_deadline() const {
+    std::optional<TimePoint> next_deadline{std::nullopt};
+
+    for (const auto& timeout : timeouts) {
+        if (not timeout.has_value()) {
+            continue;
+        }
+
+        const auto timeout_point = timeout->get_timeout_point();
+        if (not next_deadline.has_value() or timeout_point < next_deadline.value()) {
+            next_deadline = timeout_point;
+        }
+    }
+
+    return next_deadline;
+}
+
 } // namespace iso15118::d20
@@ -3,10 +3,10 @@
 #include <iso15118/io/connection_plain.hpp>
 
 #include <cassert>
-#include <chrono>
+#include <cerrno>
 #include <cinttypes>
 #include <cstring>
-#include <thread>
+#include <stdexcept>
 
 #include <endian.h>
 #include <unistd.h>
@@ -17,6 +17,7 @@
 namespace iso15118::io {
 
 static constexpr auto DEFAULT_SOCKET_BACKLOG = 4;
+static constexpr auto WAIT_FOR_FIN_TIMEOUT_MS = 2000;
 
 ConnectionPlain::ConnectionPlain(PollManager& poll_manager_, const std::string& interface_name) :
     poll_manager(poll_manager_) {
@@ -60,10 +61,19 @@ ConnectionPlain::ConnectionPlain(PollManager& poll_manager_, const std::string&
         log_and_throw("Listen on socket failed");
     }
 
-    poll_manager.register_fd(fd, [this]() { this->handle_connect(); });
+    poll_manager.register_fd(fd, [this]() { run_guarded(&ConnectionPlain::handle_connect); });
 }
 
-ConnectionPlain::~ConnectionPlain() = default;
+ConnectionPlain::~ConnectionPlain() {
+    if (close_timer) {
+        poll_manager.cancel_timer(*close_timer);
+    }
+
+    if (close_state != CloseState::CLOSED and fd != -1) {
+        poll_manager.unregister_fd(fd);
+        ::close(fd);
+    }
+}
 
 void ConnectionPlain::set_event_callback(const ConnectionEventCallback& callback) {
     this->event_callback = callback;
@@ -76,12 +86,53 @@ Ipv6EndPoint ConnectionPlain::get_public_endpoint() const {
 void ConnectionPlain::write(const uint8_t* buf, size_t len) {
     assert(connection_open);
 
+    if (not output_queue.empty()) {
+        // keep the order, the socket wasn't writable again so far
+        output_queue.push(buf, len);
+        return;
+    }
+
     const auto write_result = ::write(fd, buf, len);
 
-    if (write_result == -1) {
+    if (write_result == -1 and errno != EAGAIN) {
         log_and_throw("Failed to write()");
-    } else if (not cmp_equal(write_result, len)) {
-        log_and_throw("Could not complete write");
+    }
+
+    const size_t bytes_written = (write_result > 0) ? write_result : 0;
+    if (bytes_written == len) {
+        return;
+    }
+
+    output_queue.push(buf + bytes_written, len - bytes_written);
+    logf_warning("Socket send buffer is full, %zu bytes queued", output_queue.size());
+
+    poll_manager.set_write_interest(fd, true);
+}
+
+bool ConnectionPlain::flush_output_queue() {
+    while (not output_queue.empty()) {
+        const auto write_result = ::write(fd, output_queue.data(), output_queue.size());
+
+        if (write_result == -1) {
+            if (errno == EAGAIN) {
+                // wait until writable again
+                return true;
+            }
+
+            logf_error("Failed to write queued data with error code: %d", errno);
+            return false;
+        }
+
+        output_queue.consume(write_result);
+    }
+
+    poll_manager.set_write_interest(fd, false);
+    return true;
+}
+
+void ConnectionPlain::handle_writable() {
+    if (not flush_output_queue()) {
+        close();
     }
 }
 
@@ -104,6 +155,23 @@ ReadResult ConnectionPlain::read(uint8_t* buf, size_t len) {
     return {did_block, 0};
 }
 
+void ConnectionPlain::run_guarded(void (ConnectionPlain::*handler)()) {
+    try {
+        (this->*handler)();
+    } catch (const std::runtime_error& e) {
+        logf_error("Closing TCP connection because of: %s", e.what());
+
+        if (close_timer) {
+            poll_manager.cancel_timer(*close_timer);
+            close_timer.reset();
+        }
+
+        if (close_state != CloseState::CLOSED) {
+            finish_close();
+        }
+    }
+}
+
 void ConnectionPlain::handle_connect() {
 
     sockaddr_in6 address;
@@ -117,6 +185,7 @@ void ConnectionPlain::handle_connect() {
     const auto address_name = sockaddr_in6_to_name(address);
 
     if (not address_name) {
+        ::close(accept_fd);
         log_and_throw("Failed to determine string representation of ipv6 socket address");
     }
 
@@ -132,6 +201,7 @@ void ConnectionPlain::handle_connect() {
 
     fd = accept_fd;
     poll_manager.register_fd(fd, [this]() { this->handle_data(); });
+    poll_manager.set_write_callback(fd, [this]() { this->handle_writable(); });
 }
 
 void ConnectionPlain::handle_data() {
@@ -141,19 +211,102 @@ void ConnectionPlain::handle_data() {
 }
 
 void ConnectionPlain::close() {
+    linger_and_close(0);
+}
+
+void ConnectionPlain::linger_and_close(uint32_t linger_ms) {
+    if (close_state != CloseState::NONE) {
+        // teardown already in progress
+        return;
+    }
 
     /* tear down TCP connection gracefully */
     logf_info("Closing TCP connection");
 
-    const auto shutdown_result = shutdown(fd, SHUT_RDWR);
+    if (not connection_open) {
+        // still listening, nothing to tear down
+        finish_close();
+        return;
+    }
+
+    // from now on, incoming data is only drained, queued data still gets flushed
+    poll_manager.register_fd(fd, [this]() { this->handle_closing_data(); });
+    poll_manager.set_write_callback(fd, [this]() { this->handle_writable(); });
+    poll_manager.set_write_interest(fd, not output_queue.empty());
+
+    if (linger_ms == 0) {
+        shutdown_connection();
+        return;
+    }
+
+    close_state = CloseState::LINGER;
+    close_timer = poll_manager.schedule_timer(offset_time_point_by_ms(get_current_time_point(), linger_ms), [this]() {
+        close_timer.reset();
+        shutdown_connection();
+    });
+}
+
+void ConnectionPlain::handle_closing_data() {
+    uint8_t discard_buffer[512];
+
+    while (true) {
+        const auto read_result = ::read(fd, discard_buffer, sizeof(discard_buffer));
+        if (read_result > 0) {
+            continue;
+        }
+
+        if (read_result == -1 and errno == EAGAIN) {
+            // wait for more
+            return;
+        }
+
+        // either the FIN of the peer or an error, in both cases there is nothing more to wait for
+        peer_closed = true;
+        break;
+    }
+
+    if (close_timer) {
+        poll_manager.cancel_timer(*close_timer);
+        close_timer.reset();
+    }
+
+    if (close_state == CloseState::LINGER) {
+        shutdown_connection();
+    } else if (close_state == CloseState::WAIT_FOR_FIN) {
+        finish_close();
+    }
+}
+
+void ConnectionPlain::shutdown_connection() {
+    if (not output_queue.empty()) {
+        // last chance, everything still queued after this gets lost
+        flush_output_queue();
+        if (not output_queue.empty()) {
+            logf_warning("Dropping %zu queued bytes on shutdown", output_queue.size());
+        }
+    }
+
+    const auto shutdown_result = shutdown(fd, SHUT_WR);
 
     if (shutdown_result == -1) {
         logf_error("shutdown() failed");
     }
 
+    if (peer_closed) {
+        finish_close();
+        return;
+    }
+
     // Waiting for client closing the connection
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    close_state = CloseState::WAIT_FOR_FIN;
+    close_timer = poll_manager.schedule_timer(
+        offset_time_point_by_ms(get_current_time_point(), WAIT_FOR_FIN_TIMEOUT_MS), [this]() {
+            close_timer.reset();
+            finish_close();
+        });
+}
 
+void ConnectionPlain::finish_close() {
     poll_manager.unregister_fd(fd);
 
     const auto close_shutdown = ::close(fd);
@@ -164,6 +317,7 @@ void ConnectionPlain::close() {
 
     logf_info("TCP connection closed gracefully");
 
+    close_state = CloseState::CLOSED;
     connection_open = false;
     call_if_available(event_callback, ConnectionEvent::CLOSED);
 }
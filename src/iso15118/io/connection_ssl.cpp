@@ -4,25 +4,34 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cinttypes>
 #include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <unistd.h>
 #include <vector>
 
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <sys/socket.h>
 
 #include <openssl/bio.h>
+#include <openssl/core_names.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 
 #include <iso15118/detail/helper.hpp>
 #include <iso15118/detail/io/helper_ssl.hpp>
+#include <iso15118/detail/io/session_ticket_keys.hpp>
 #include <iso15118/detail/io/socket_helper.hpp>
+#include <iso15118/detail/io/tls_key_log_writer.hpp>
 #include <iso15118/io/sdp_server.hpp>
 
 namespace std {
@@ -42,15 +51,34 @@ public:
 
 namespace iso15118::io {
 
+struct SSLServerState {
+    // nullptr, if session resumption is disabled
+    std::unique_ptr<SessionTicketKeyStore> ticket_keys;
+    // nullptr, if tls key logging is disabled
+    std::unique_ptr<TlsKeyLogWriter> key_log_writer;
+
+    std::atomic<uint32_t> full_handshakes{0};
+    std::atomic<uint32_t> resumed_handshakes{0};
+    std::atomic<uint32_t> ktls_send{0};
+    std::atomic<uint32_t> ktls_receive{0};
+};
+
 struct SSLContext {
-    std::unique_ptr<SSL_CTX> ssl_ctx;
+    std::shared_ptr<SSL_CTX> ssl_ctx;
     std::unique_ptr<SSL> ssl;
     int fd{-1};
     int accept_fd{-1};
     std::string interface_name;
     bool enable_key_logging{false};
-    std::filesystem::path tls_key_log_file_path{};
-    std::unique_ptr<io::TlsKeyLoggingServer> key_server;
+    bool enable_ktls{false};
+
+    // result of the last handshake step run by the handshake workers, handed over by the eventfd
+    int handshake_event_fd{-1};
+    std::future<void> handshake_job;
+    int handshake_result{0};
+    int handshake_error{SSL_ERROR_NONE};
+    std::string handshake_error_message;
+    std::shared_ptr<io::TlsKeyLoggingServer> key_server;
     bool enforce_tls_1_3{false};
     std::optional<sha512_hash_t> vehicle_cert_hash{std::nullopt};
 };
@@ -60,9 +88,12 @@ namespace {
 constexpr auto DEFAULT_SOCKET_BACKLOG = 4;
 constexpr auto TLS_PORT = 50000;
 constexpr auto NAME_LENGTH = 256;
+constexpr auto WAIT_FOR_FIN_TIMEOUT_MS = 2000;
 
 int ssl_keylog_server_index{-1};
-int ssl_keylog_file_index{-1};
+int ssl_server_state_index{-1};
+
+constexpr unsigned char SESSION_ID_CONTEXT[] = "iso15118";
 
 std::string convert_ssl_tls_versions_to_string(uint16_t version) {
     switch (version) {
@@ -177,32 +208,95 @@ int handle_certificate_cb(SSL* ssl, void* /* arg */) {
     return 1;
 }
 
+void init_ex_data_indices() {
+    // NOTE: the indices are shared by all contexts, so they are only allocated once
+    static std::once_flag once;
+    std::call_once(once, []() {
+        ssl_keylog_server_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+        ssl_server_state_index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    });
+}
+
+SSLServerState* get_server_state(const SSL* ssl) {
+    if (ssl_server_state_index == -1) {
+        return nullptr;
+    }
+    return static_cast<SSLServerState*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), ssl_server_state_index));
+}
+
 void keylog_callback(const SSL* ssl, const char* line) {
-    auto key_logging_server = static_cast<io::TlsKeyLoggingServer*>(SSL_get_ex_data(ssl, ssl_keylog_server_index));
+    const auto state = get_server_state(ssl);
+    if (state == nullptr or not state->key_log_writer) {
+        return;
+    }
 
-    std::string key_log_msg = "TLS Handshake keys on port ";
-    key_log_msg += std::to_string(key_logging_server->get_port()) + ": ";
-    key_log_msg += std::string(line);
+    // NOTE: only buffers the line, the writer's thread does the rest
+    auto key_logging_server =
+        static_cast<std::shared_ptr<io::TlsKeyLoggingServer>*>(SSL_get_ex_data(ssl, ssl_keylog_server_index));
+    state->key_log_writer->push(line, key_logging_server != nullptr ? *key_logging_server : nullptr);
+}
 
-    logf_info(key_log_msg.c_str());
+int session_ticket_key_cb(SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+                          EVP_MAC_CTX* mac_ctx, int enc) {
+    const auto state = get_server_state(ssl);
+    if (state == nullptr or not state->ticket_keys) {
+        return -1;
+    }
 
-    if (key_logging_server->get_fd() != -1) {
-        const auto result = key_logging_server->send(line);
-        if (not cmp_equal(result, strlen(line))) {
-            const auto error_msg = adding_err_msg("key_logging_server send() failed");
-            logf_error(error_msg.c_str());
+    const auto init_mac = [mac_ctx](SessionTicketKey& key) {
+        std::array<OSSL_PARAM, 3> params = {
+            OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac_key.data(), key.hmac_key.size()),
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(SN_sha256), 0),
+            OSSL_PARAM_construct_end()};
+        return EVP_MAC_CTX_set_params(mac_ctx, params.data()) == 1;
+    };
+
+    // NOTE: errors of the key store (i.e. no random data for a new key) must not unwind through openssl
+    if (enc == 1) {
+        SessionTicketKey key;
+        try {
+            key = state->ticket_keys->get_encryption_key();
+        } catch (const std::exception& e) {
+            logf_error("Failed to get the session ticket key: %s", e.what());
+            // the session gets no ticket
+            return -1;
         }
+
+        if (RAND_bytes(iv, EVP_CIPHER_get_iv_length(EVP_aes_256_cbc())) != 1) {
+            return -1;
+        }
+
+        std::copy(key.name.begin(), key.name.end(), key_name);
+
+        if (EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key.data(), iv) != 1 or
+            not init_mac(key)) {
+            return -1;
+        }
+
+        return 1;
+    }
+
+    std::optional<SessionTicketKeyLookup> lookup;
+    try {
+        lookup = state->ticket_keys->find_decryption_key(key_name);
+    } catch (const std::exception& e) {
+        logf_error("Failed to look up the session ticket key: %s", e.what());
+        // falls back to a full handshake
+        return 0;
     }
 
-    const auto keylog_file_path =
-        static_cast<std::filesystem::path*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), ssl_keylog_file_index));
+    if (not lookup) {
+        // unknown or expired key, falls back to a full handshake
+        return 0;
+    }
 
-    if (not keylog_file_path->empty()) {
-        std::ofstream ofs;
-        ofs.open(keylog_file_path->string(), std::ofstream::out | std::ofstream::app);
-        ofs << line << std::endl;
-        ofs.close();
+    if (EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, lookup->key.aes_key.data(), iv) != 1 or
+        not init_mac(lookup->key)) {
+        return -1;
     }
+
+    // a ticket of the previous key gets replaced by one of the current key
+    return lookup->renew_ticket ? 2 : 1;
 }
 
 int private_key_callback(char* buf, int size, [[maybe_unused]] int rwflag, void* userdata) {
@@ -217,14 +311,15 @@ int private_key_callback(char* buf, int size, [[maybe_unused]] int rwflag, void*
     return max_copy_chars;
 }
 
-SSL_CTX* init_ssl(const config::SSLConfig& ssl_config) {
+std::shared_ptr<SSL_CTX> init_ssl(const config::SSLConfig& ssl_config, const std::shared_ptr<SSLServerState>& state) {
 
     // Note: openssl does not provide support for ECDH-ECDSA-AES128-SHA256 anymore
     static constexpr auto TLS1_2_CIPHERSUITES = "ECDHE-ECDSA-AES128-SHA256";
     static constexpr auto TLS1_3_CIPHERSUITES = "TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256";
 
     const SSL_METHOD* method = TLS_server_method();
-    const auto ctx = SSL_CTX_new(method);
+    auto ctx_ptr = std::unique_ptr<SSL_CTX>(SSL_CTX_new(method));
+    const auto ctx = ctx_ptr.get();
 
     if (ctx == nullptr) {
         log_and_raise_openssl_error("Failed in SSL_CTX_new()");
@@ -266,6 +361,9 @@ SSL_CTX* init_ssl(const config::SSLConfig& ssl_config) {
         log_and_raise_openssl_error("Failed in SSL_CTX_use_PrivateKey_file()");
     }
 
+    // the password is only needed for loading the key, the context might outlive the config
+    SSL_CTX_set_default_passwd_cb_userdata(ctx, nullptr);
+
     // Loading root certificates to verify client (only for tls 1.3)
     if (SSL_CTX_load_verify_file(ctx, ssl_config.path_certificate_v2g_root.c_str()) == 0) {
         logf_error("Verify V2G root not found!");
@@ -279,43 +377,196 @@ SSL_CTX* init_ssl(const config::SSLConfig& ssl_config) {
 
     SSL_CTX_set_client_hello_cb(ctx, &client_hello_cb, nullptr);
 
+    init_ex_data_indices();
+
+    if (ssl_config.enable_ktls) {
+        // NOTE: the kernel only handles AEAD cipher suites, so connections using the TLS 1.2 cipher suite above always
+        // stay in user space
+        SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+    }
+
+    if (ssl_config.enable_session_resumption) {
+        // the tickets are stateless, so there is no session cache on the server side
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+        // needed for resuming sessions with a verified client certificate
+        SSL_CTX_set_session_id_context(ctx, SESSION_ID_CONTEXT, sizeof(SESSION_ID_CONTEXT) - 1);
+        if (ssl_config.session_ticket_key_rotation_s > 0) {
+            SSL_CTX_set_timeout(ctx, 2 * static_cast<long>(ssl_config.session_ticket_key_rotation_s));
+        }
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, session_ticket_key_cb);
+    } else {
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+        SSL_CTX_set_num_tickets(ctx, 0);
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+    }
+
+    if (ssl_server_state_index != -1) {
+        SSL_CTX_set_ex_data(ctx, ssl_server_state_index, state.get());
+    }
+
     // TODO(SL): Adding multi root support with certificate_authorities extension
     // SSL_CTX_set_cert_cb(ctx, &handle_certificate_cb, nullptr);
 
     if (ssl_config.enable_tls_key_logging) {
-        ssl_keylog_file_index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
-        ssl_keylog_server_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
-
-        if (ssl_keylog_file_index == -1 or ssl_keylog_server_index == -1) {
-            auto error_msg = std::string("_get_ex_new_index failed: ssl_keylog_file_index: ");
-            error_msg += std::to_string(ssl_keylog_file_index);
-            error_msg += ", ssl_keylog_server_index: " + std::to_string(ssl_keylog_server_index);
+        if (ssl_keylog_server_index == -1 or ssl_server_state_index == -1) {
+            auto error_msg = std::string("_get_ex_new_index failed: ssl_keylog_server_index: ");
+            error_msg += std::to_string(ssl_keylog_server_index);
+            error_msg += ", ssl_server_state_index: " + std::to_string(ssl_server_state_index);
             logf_error(error_msg.c_str());
         } else {
             SSL_CTX_set_keylog_callback(ctx, keylog_callback);
         }
     }
 
-    return ctx;
+    // the server state is owned by the deleter, so it lives as long as the context
+    return {ctx_ptr.release(), [state](SSL_CTX* ptr) { ::SSL_CTX_free(ptr); }};
 }
 } // namespace
 
+SSLServerContext::SSLServerContext(const config::SSLConfig& config_) :
+    config(config_), state(std::make_shared<SSLServerState>()) {
+
+    if (config.handshake_worker_threads > 0) {
+        handshake_workers = std::make_shared<WorkerPool>(config.handshake_worker_threads);
+    }
+
+    if (config.enable_session_resumption) {
+        state->ticket_keys = std::make_unique<SessionTicketKeyStore>(
+            std::chrono::seconds(config.session_ticket_key_rotation_s), config.session_ticket_key_file);
+    }
+
+    if (config.enable_tls_key_logging) {
+        state->key_log_writer = std::make_unique<TlsKeyLogWriter>(config.tls_key_logging_path / "tls_session_keys.log");
+    }
+
+    reload();
+}
+
+SSLServerContext::~SSLServerContext() {
+    if (watch_fd != -1) {
+        ::close(watch_fd);
+    }
+}
+
+bool SSLServerContext::reload() {
+    // NOTE: the files are loaded without holding the lock, so new connections are not blocked meanwhile
+    std::shared_ptr<SSL_CTX> new_ctx;
+    try {
+        new_ctx = init_ssl(config, state);
+    } catch (const std::runtime_error& e) {
+        logf_error("Failed to load the TLS server context: %s", e.what());
+        return false;
+    }
+
+    std::scoped_lock lock(mutex);
+    ctx = std::move(new_ctx);
+    return true;
+}
+
+std::shared_ptr<SSL_CTX> SSLServerContext::get() const {
+    std::scoped_lock lock(mutex);
+    return ctx;
+}
+
+TlsHandshakeStats SSLServerContext::get_handshake_stats() const {
+    return {state->full_handshakes, state->resumed_handshakes, state->ktls_send, state->ktls_receive};
+}
+
+int SSLServerContext::start_watching() {
+    if (watch_fd != -1) {
+        return watch_fd;
+    }
+
+    if (config.backend != config::CertificateBackend::EVEREST_LAYOUT) {
+        return -1;
+    }
+
+    watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch_fd == -1) {
+        logf_error("%s", adding_err_msg("inotify_init1() failed").c_str());
+        return -1;
+    }
+
+    std::map<std::filesystem::path, std::vector<std::string>> files_per_directory;
+    for (const auto& file : {config.path_certificate_chain, config.path_certificate_key,
+                             config.path_certificate_v2g_root, config.path_certificate_mo_root}) {
+        if (file.empty()) {
+            continue;
+        }
+
+        const auto path = std::filesystem::absolute(file);
+        files_per_directory[path.parent_path()].push_back(path.filename().string());
+    }
+
+    // NOTE: the directories are watched instead of the files, because updated files are usually moved into place
+    for (auto& [directory, files] : files_per_directory) {
+        const auto wd = inotify_add_watch(watch_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd == -1) {
+            const auto msg = adding_err_msg("inotify_add_watch() failed for " + directory.string());
+            logf_warning("%s", msg.c_str());
+            continue;
+        }
+
+        watched_files[wd] = std::move(files);
+    }
+
+    return watch_fd;
+}
+
+bool SSLServerContext::handle_file_events() {
+    alignas(inotify_event) char buffer[4096];
+    bool changed{false};
+
+    while (true) {
+        const auto length = ::read(watch_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            const auto it = watched_files.find(event->wd);
+            if (it == watched_files.end() or event->len == 0) {
+                continue;
+            }
+
+            const auto& files = it->second;
+            if (std::find(files.begin(), files.end(), event->name) != files.end()) {
+                changed = true;
+            }
+        }
+    }
+
+    if (not changed) {
+        return false;
+    }
+
+    // NOTE: while the files are replaced one by one, the certificate and the key might not match, so the previous
+    // setup is kept until the last file has been written
+    logf_info("TLS certificate files changed, reloading the server context");
+    return reload();
+}
+
 ConnectionSSL::ConnectionSSL(PollManager& poll_manager_, const std::string& interface_name_,
-                             const config::SSLConfig& ssl_config) :
-    poll_manager(poll_manager_), ssl(std::make_unique<SSLContext>()) {
+                             const SSLServerContext& server_context) :
+    poll_manager(poll_manager_),
+    ssl(std::make_unique<SSLContext>()),
+    handshake_workers(server_context.get_handshake_workers()) {
+
+    const auto& ssl_config = server_context.get_config();
 
     ssl->interface_name = interface_name_;
     ssl->enable_key_logging = ssl_config.enable_tls_key_logging;
     ssl->enforce_tls_1_3 = ssl_config.enforce_tls_1_3;
+    ssl->enable_ktls = ssl_config.enable_ktls;
 
-    // Openssl stuff missing!
-    const auto ssl_ctx = init_ssl(ssl_config);
-    ssl->ssl_ctx = std::unique_ptr<SSL_CTX>(ssl_ctx);
-
-    if (ssl_keylog_file_index != -1) {
-        ssl->tls_key_log_file_path = ssl_config.tls_key_logging_path / "tls_session_keys.log";
-        SSL_CTX_set_ex_data(ssl->ssl_ctx.get(), ssl_keylog_file_index, &ssl->tls_key_log_file_path);
+    ssl->ssl_ctx = server_context.get();
+    if (ssl->ssl_ctx == nullptr) {
+        log_and_throw("No TLS server context available");
     }
+
     sockaddr_in6 address;
     if (not get_first_sockaddr_in6_for_interface(interface_name_, address)) {
         const auto msg = "Failed to get ipv6 socket address for interface " + interface_name_;
@@ -365,10 +616,28 @@ ConnectionSSL::ConnectionSSL(PollManager& poll_manager_, const std::string& inte
         log_and_throw("Listen on socket failed");
     }
 
-    poll_manager.register_fd(ssl->fd, [this]() { this->handle_connect(); });
+    poll_manager.register_fd(ssl->fd, [this]() { run_guarded(&ConnectionSSL::handle_connect); });
 }
 
-ConnectionSSL::~ConnectionSSL() = default;
+ConnectionSSL::~ConnectionSSL() {
+    release_handshake_job();
+
+    if (close_timer) {
+        poll_manager.cancel_timer(*close_timer);
+    }
+
+    if (close_state == CloseState::CLOSED) {
+        return;
+    }
+
+    if (ssl->accept_fd != -1) {
+        // the accepted socket gets closed together with the SSL object
+        poll_manager.unregister_fd(ssl->accept_fd);
+    } else if (ssl->fd != -1) {
+        poll_manager.unregister_fd(ssl->fd);
+        ::close(ssl->fd);
+    }
+}
 
 void ConnectionSSL::set_event_callback(const ConnectionEventCallback& callback) {
     event_callback = callback;
@@ -385,6 +654,12 @@ std::optional<sha512_hash_t> ConnectionSSL::get_vehicle_cert_hash() const {
 void ConnectionSSL::write(const uint8_t* buf, size_t len) {
     assert(handshake_complete); // TODO(sl): Adding states?
 
+    if (not output_queue.empty()) {
+        // keep the order, the pending write didn't complete so far
+        output_queue.push(buf, len);
+        return;
+    }
+
     size_t writebytes = 0;
     const auto ssl_ptr = ssl->ssl.get();
 
@@ -392,9 +667,57 @@ void ConnectionSSL::write(const uint8_t* buf, size_t len) {
 
     if (ssl_write_result <= 0) {
         const auto ssl_err_raw = SSL_get_error(ssl_ptr, ssl_write_result);
-        log_and_raise_openssl_error("Failed to SSL_write_ex(): " + std::to_string(ssl_err_raw));
-    } else if (writebytes != len) {
-        log_and_throw("Didn't complete to write");
+        if ((ssl_err_raw != SSL_ERROR_WANT_WRITE) and (ssl_err_raw != SSL_ERROR_WANT_READ)) {
+            log_and_raise_openssl_error("Failed to SSL_write_ex(): " + std::to_string(ssl_err_raw));
+        }
+        writebytes = 0;
+    }
+
+    if (writebytes == len) {
+        return;
+    }
+
+    // NOTE: SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER allows to retry the write from the queue
+    output_queue.push(buf + writebytes, len - writebytes);
+    logf_warning("Socket send buffer is full, %zu bytes queued", output_queue.size());
+
+    poll_manager.set_write_interest(ssl->accept_fd, true);
+}
+
+bool ConnectionSSL::flush_output_queue() {
+    const auto ssl_ptr = ssl->ssl.get();
+
+    while (not output_queue.empty()) {
+        size_t writebytes = 0;
+        const auto ssl_write_result = SSL_write_ex(ssl_ptr, output_queue.data(), output_queue.size(), &writebytes);
+
+        if (ssl_write_result <= 0) {
+            const auto ssl_error = SSL_get_error(ssl_ptr, ssl_write_result);
+            if (ssl_error == SSL_ERROR_WANT_WRITE) {
+                // wait until writable again
+                poll_manager.set_write_interest(ssl->accept_fd, true);
+                return true;
+            }
+            if (ssl_error == SSL_ERROR_WANT_READ) {
+                // the socket is writable, so waiting for it would spin, handle_data retries the flush
+                poll_manager.set_write_interest(ssl->accept_fd, false);
+                return true;
+            }
+
+            logf_error("%s", log_openssl_error("Failed to write queued data: " + std::to_string(ssl_error)).c_str());
+            return false;
+        }
+
+        output_queue.consume(writebytes);
+    }
+
+    poll_manager.set_write_interest(ssl->accept_fd, false);
+    return true;
+}
+
+void ConnectionSSL::handle_writable() {
+    if (not flush_output_queue()) {
+        close();
     }
 }
 
@@ -407,7 +730,8 @@ ReadResult ConnectionSSL::read(uint8_t* buf, size_t len) {
     const auto ssl_read_result = SSL_read_ex(ssl_ptr, buf, len, &readbytes);
 
     if (ssl_read_result > 0) {
-        const auto would_block = (readbytes < len);
+        // NOTE: a single SSL_read only returns the data of one record, more might be buffered already
+        const auto would_block = (readbytes < len) and (SSL_has_pending(ssl_ptr) == 0);
         return {would_block, readbytes};
     }
 
@@ -422,6 +746,23 @@ ReadResult ConnectionSSL::read(uint8_t* buf, size_t len) {
     return {false, 0};
 }
 
+void ConnectionSSL::run_guarded(void (ConnectionSSL::*handler)()) {
+    try {
+        (this->*handler)();
+    } catch (const std::runtime_error& e) {
+        logf_error("Closing TLS connection because of: %s", e.what());
+
+        if (close_timer) {
+            poll_manager.cancel_timer(*close_timer);
+            close_timer.reset();
+        }
+
+        if (close_state != CloseState::CLOSED) {
+            finish_close();
+        }
+    }
+}
+
 void ConnectionSSL::handle_connect() {
 
     const auto peer = BIO_ADDR_new();
@@ -438,6 +779,7 @@ void ConnectionSSL::handle_connect() {
 
     poll_manager.unregister_fd(ssl->fd);
     ::close(ssl->fd);
+    ssl->fd = -1;
 
     call_if_available(event_callback, ConnectionEvent::ACCEPTED);
 
@@ -448,15 +790,17 @@ void ConnectionSSL::handle_connect() {
 
     SSL_set_bio(ssl_ptr, socket_bio, socket_bio);
     SSL_set_accept_state(ssl_ptr);
+    SSL_set_mode(ssl_ptr, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
     SSL_set_app_data(ssl_ptr, this);
 
     if (ssl->enable_key_logging) {
         const auto port = std::stoul(service);
-        ssl->key_server = std::make_unique<io::TlsKeyLoggingServer>(ssl->interface_name, port);
-        SSL_set_ex_data(ssl_ptr, ssl_keylog_server_index, ssl->key_server.get());
+        ssl->key_server = std::make_shared<io::TlsKeyLoggingServer>(ssl->interface_name, port);
+        SSL_set_ex_data(ssl_ptr, ssl_keylog_server_index, &ssl->key_server);
     }
 
-    poll_manager.register_fd(ssl->accept_fd, [this]() { this->handle_data(); });
+    poll_manager.register_fd(ssl->accept_fd, [this]() { run_guarded(&ConnectionSSL::handle_data); });
+    poll_manager.set_write_callback(ssl->accept_fd, [this]() { this->handle_writable(); });
 
     OPENSSL_free(ip);
     OPENSSL_free(service);
@@ -465,7 +809,17 @@ void ConnectionSSL::handle_connect() {
 }
 
 void ConnectionSSL::handle_data() {
+    if (not output_queue.empty() and not flush_output_queue()) {
+        close();
+        return;
+    }
+
     if (not handshake_complete) {
+        if (handshake_workers) {
+            start_handshake_job();
+            return;
+        }
+
         const auto ssl_ptr = ssl->ssl.get();
 
         const auto ssl_handshake_result = SSL_accept(ssl_ptr);
@@ -478,66 +832,241 @@ void ConnectionSSL::handle_data() {
                 return;
             }
             log_and_raise_openssl_error("Failed to SSL_accept(): " + std::to_string(ssl_error));
-        } else {
-            logf_info("Handshake complete!");
-
-            const auto peer = SSL_get0_peer_certificate(ssl_ptr);
-
-            if (SSL_get_verify_mode(ssl_ptr) != SSL_VERIFY_NONE and peer) {
-
-                const auto verify_result = SSL_get_verify_result(ssl_ptr);
-                if (verify_result == X509_V_OK) {
-                    logf_info("Verify certificate result is okay");
-                    char name[NAME_LENGTH]{};
-                    x509_name_oneline(X509_get_subject_name(peer), name, sizeof(name));
-                    logf_debug("Peer subject name: %s", name);
-                    name[0] = '\0';
-                    x509_name_oneline(X509_get_issuer_name(peer), name, sizeof(name));
-                    logf_debug("Peer issuer name: %s", name);
-
-                    unsigned int length = 0;
-                    auto& vehicle_hash = ssl->vehicle_cert_hash.emplace();
-                    const auto result_digest = X509_digest(peer, EVP_sha512(), vehicle_hash.data(), &length);
-
-                    if (result_digest) {
-                        std::stringstream ss;
-                        ss << std::uppercase << std::hex << std::setw(2) << std::setfill('0')
-                           << static_cast<int>(vehicle_hash[0]);
-                        for (unsigned int i = 1; i < length; ++i) {
-                            ss << ":" << std::uppercase << std::hex << std::setw(2) << std::setfill('0')
-                               << (int)static_cast<int>(vehicle_hash[i]);
-                        }
-                        logf_debug("sha512 fingerprint: %s", ss.str().c_str());
-                        // openssl command: openssl x509 -in *.pem -noout -fingerprint -sha512
-                    } else {
-                        logf_error("X509_digest failed");
-                    }
-                } else {
-                    logf_error("Verify certificate result is not okay");
+        }
+
+        finish_handshake();
+        return;
+    }
+
+    call_if_available(event_callback, ConnectionEvent::NEW_DATA);
+}
+
+void ConnectionSSL::finish_handshake() {
+    const auto ssl_ptr = ssl->ssl.get();
+
+    const auto resumed = (SSL_session_reused(ssl_ptr) == 1);
+    logf_info(resumed ? "Handshake complete (resumed session)!" : "Handshake complete!");
+
+    const auto ktls_send = BIO_get_ktls_send(SSL_get_wbio(ssl_ptr));
+    const auto ktls_receive = BIO_get_ktls_recv(SSL_get_rbio(ssl_ptr));
+
+    if (ssl->enable_ktls) {
+        logf_info("TLS records (%s) are sent by %s and received by %s", SSL_get_cipher_name(ssl_ptr),
+                  ktls_send ? "the kernel" : "OpenSSL", ktls_receive ? "the kernel" : "OpenSSL");
+    }
+
+    if (const auto state = get_server_state(ssl_ptr)) {
+        (resumed ? state->resumed_handshakes : state->full_handshakes)++;
+        state->ktls_send += ktls_send ? 1 : 0;
+        state->ktls_receive += ktls_receive ? 1 : 0;
+    }
+
+    const auto peer = SSL_get0_peer_certificate(ssl_ptr);
+
+    if (SSL_get_verify_mode(ssl_ptr) != SSL_VERIFY_NONE and peer) {
+
+        const auto verify_result = SSL_get_verify_result(ssl_ptr);
+        if (verify_result == X509_V_OK) {
+            logf_info("Verify certificate result is okay");
+            char name[NAME_LENGTH]{};
+            x509_name_oneline(X509_get_subject_name(peer), name, sizeof(name));
+            logf_debug("Peer subject name: %s", name);
+            name[0] = '\0';
+            x509_name_oneline(X509_get_issuer_name(peer), name, sizeof(name));
+            logf_debug("Peer issuer name: %s", name);
+
+            unsigned int length = 0;
+            auto& vehicle_hash = ssl->vehicle_cert_hash.emplace();
+            const auto result_digest = X509_digest(peer, EVP_sha512(), vehicle_hash.data(), &length);
+
+            if (result_digest) {
+                std::stringstream ss;
+                ss << std::uppercase << std::hex << std::setw(2) << std::setfill('0')
+                   << static_cast<int>(vehicle_hash[0]);
+                for (unsigned int i = 1; i < length; ++i) {
+                    ss << ":" << std::uppercase << std::hex << std::setw(2) << std::setfill('0')
+                       << (int)static_cast<int>(vehicle_hash[i]);
                 }
+                logf_debug("sha512 fingerprint: %s", ss.str().c_str());
+                // openssl command: openssl x509 -in *.pem -noout -fingerprint -sha512
+            } else {
+                logf_error("X509_digest failed");
             }
+        } else {
+            logf_error("Verify certificate result is not okay");
+        }
+    }
 
-            handshake_complete = true;
-            if (ssl->enable_key_logging) {
-                ssl->key_server.reset();
-            }
+    handshake_complete = true;
+    if (ssl->enable_key_logging) {
+        ssl->key_server.reset();
+    }
 
-            call_if_available(event_callback, ConnectionEvent::OPEN);
+    call_if_available(event_callback, ConnectionEvent::OPEN);
+}
 
-            return;
+void ConnectionSSL::start_handshake_job() {
+    if (ssl->handshake_job.valid()) {
+        return;
+    }
+
+    if (ssl->handshake_event_fd == -1) {
+        ssl->handshake_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (ssl->handshake_event_fd == -1) {
+            log_and_throw(adding_err_msg("Failed to create the handshake eventfd").c_str());
         }
+        poll_manager.register_fd(ssl->handshake_event_fd,
+                                 [this]() { run_guarded(&ConnectionSSL::handle_handshake_job_done); });
     }
 
-    call_if_available(event_callback, ConnectionEvent::NEW_DATA);
+    // NOTE: the SSL object belongs to the job until it is done, level triggered polling would also fire all the time
+    poll_manager.unregister_fd(ssl->accept_fd);
+
+    ssl->handshake_job = handshake_workers->post([context = ssl.get()]() {
+        const auto ssl_ptr = context->ssl.get();
+
+        context->handshake_result = SSL_accept(ssl_ptr);
+        context->handshake_error = SSL_ERROR_NONE;
+
+        if (context->handshake_result <= 0) {
+            // NOTE: the error queue of openssl is thread local, so it needs to be read here
+            context->handshake_error = SSL_get_error(ssl_ptr, context->handshake_result);
+            if ((context->handshake_error != SSL_ERROR_WANT_READ) and
+                (context->handshake_error != SSL_ERROR_WANT_WRITE)) {
+                context->handshake_error_message =
+                    log_openssl_error("Failed to SSL_accept(): " + std::to_string(context->handshake_error));
+            }
+        }
+
+        eventfd_write(context->handshake_event_fd, 1);
+    });
+}
+
+void ConnectionSSL::handle_handshake_job_done() {
+    eventfd_t tmp;
+    eventfd_read(ssl->handshake_event_fd, &tmp);
+
+    if (not ssl->handshake_job.valid()) {
+        return;
+    }
+
+    // rethrows, if the job failed
+    ssl->handshake_job.get();
+
+    poll_manager.register_fd(ssl->accept_fd, [this]() { run_guarded(&ConnectionSSL::handle_data); });
+    poll_manager.set_write_callback(ssl->accept_fd, [this]() { this->handle_writable(); });
+
+    if (ssl->handshake_result > 0) {
+        release_handshake_job();
+        finish_handshake();
+        return;
+    }
+
+    if ((ssl->handshake_error == SSL_ERROR_WANT_READ) or (ssl->handshake_error == SSL_ERROR_WANT_WRITE)) {
+        // continues, once the socket is readable again
+        return;
+    }
+
+    throw std::runtime_error(ssl->handshake_error_message);
+}
+
+void ConnectionSSL::release_handshake_job() {
+    if (ssl->handshake_job.valid()) {
+        // NOTE: a handshake step is short, so waiting for it is fine
+        ssl->handshake_job.wait();
+        ssl->handshake_job = {};
+    }
+
+    if (ssl->handshake_event_fd != -1) {
+        poll_manager.unregister_fd(ssl->handshake_event_fd);
+        ::close(ssl->handshake_event_fd);
+        ssl->handshake_event_fd = -1;
+    }
 }
 
 void ConnectionSSL::close() {
+    linger_and_close(0);
+}
+
+void ConnectionSSL::linger_and_close(uint32_t linger_ms) {
+    if (close_state != CloseState::NONE) {
+        // teardown already in progress
+        return;
+    }
+
     /* tear down TLS connection gracefully */
     logf_info("Closing TLS connection");
 
+    if (not handshake_complete) {
+        // either still listening or within the handshake, nothing to tear down gracefully
+        finish_close();
+        return;
+    }
+
+    // from now on, incoming data is only drained, queued data still gets flushed
+    poll_manager.register_fd(ssl->accept_fd, [this]() { this->handle_closing_data(); });
+    poll_manager.set_write_callback(ssl->accept_fd, [this]() { this->handle_writable(); });
+    poll_manager.set_write_interest(ssl->accept_fd, not output_queue.empty());
+
+    if (linger_ms == 0) {
+        shutdown_connection();
+        return;
+    }
+
+    close_state = CloseState::LINGER;
+    close_timer = poll_manager.schedule_timer(offset_time_point_by_ms(get_current_time_point(), linger_ms), [this]() {
+        close_timer.reset();
+        shutdown_connection();
+    });
+}
+
+void ConnectionSSL::handle_closing_data() {
     const auto ssl_ptr = ssl->ssl.get();
+    uint8_t discard_buffer[512];
+
+    while (true) {
+        size_t readbytes = 0;
+        const auto ssl_read_result = SSL_read_ex(ssl_ptr, discard_buffer, sizeof(discard_buffer), &readbytes);
+        if (ssl_read_result > 0) {
+            continue;
+        }
+
+        const auto ssl_error = SSL_get_error(ssl_ptr, ssl_read_result);
+        if ((ssl_error == SSL_ERROR_WANT_READ) or (ssl_error == SSL_ERROR_WANT_WRITE)) {
+            // wait for more
+            return;
+        }
+
+        // either a close_notify, the FIN of the peer or an error, in all cases there is nothing more to wait for
+        ERR_clear_error();
+        peer_closed = true;
+        break;
+    }
 
-    const auto ssl_close_result = SSL_shutdown(ssl_ptr); // TODO(sl): Correct shutdown handling
+    if (close_timer) {
+        poll_manager.cancel_timer(*close_timer);
+        close_timer.reset();
+    }
+
+    if (close_state == CloseState::LINGER) {
+        shutdown_connection();
+    } else if (close_state == CloseState::WAIT_FOR_FIN) {
+        finish_close();
+    }
+}
+
+void ConnectionSSL::shutdown_connection() {
+    const auto ssl_ptr = ssl->ssl.get();
+
+    if (not output_queue.empty()) {
+        // last chance, everything still queued after this gets lost
+        flush_output_queue();
+        if (not output_queue.empty()) {
+            logf_warning("Dropping %zu queued bytes on shutdown", output_queue.size());
+        }
+    }
+
+    const auto ssl_close_result = SSL_shutdown(ssl_ptr);
 
     if (ssl_close_result < 0) {
         const auto ssl_error = SSL_get_error(ssl_ptr, ssl_close_result);
@@ -546,13 +1075,38 @@ void ConnectionSSL::close() {
         }
     }
 
-    // TODO(sl): Test if correct
+    // SSL_shutdown returns 1, if the close_notify of the peer was already received
+    if (peer_closed or ssl_close_result == 1) {
+        finish_close();
+        return;
+    }
 
-    ::close(ssl->accept_fd);
-    poll_manager.unregister_fd(ssl->accept_fd);
+    // Waiting for client closing the connection
+    close_state = CloseState::WAIT_FOR_FIN;
+    close_timer = poll_manager.schedule_timer(
+        offset_time_point_by_ms(get_current_time_point(), WAIT_FOR_FIN_TIMEOUT_MS), [this]() {
+            close_timer.reset();
+            finish_close();
+        });
+}
+
+void ConnectionSSL::finish_close() {
+    release_handshake_job();
+
+    if (ssl->accept_fd != -1) {
+        poll_manager.unregister_fd(ssl->accept_fd);
+        // NOTE: the socket bio owns the accepted socket (BIO_CLOSE), so freeing the SSL object closes it
+        ssl->ssl.reset();
+        ssl->accept_fd = -1;
+    } else {
+        poll_manager.unregister_fd(ssl->fd);
+        ::close(ssl->fd);
+        ssl->fd = -1;
+    }
 
     logf_info("TLS connection closed gracefully");
 
+    close_state = CloseState::CLOSED;
     call_if_available(event_callback, ConnectionEvent::CLOSED);
 }
 
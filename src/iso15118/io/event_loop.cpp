@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/io/event_loop.hpp>
+
+#include <stdexcept>
+
+#include <iso15118/detail/helper.hpp>
+
+namespace iso15118::io {
+
+EventLoop::EventLoop(PollManager& poll_manager_) : poll_manager(poll_manager_) {
+    poll_manager.set_notify_callback([this]() { run_tasks(); });
+}
+
+EventLoop::EventLoop() : owned_poll_manager(std::make_unique<PollManager>()), poll_manager(*owned_poll_manager) {
+    poll_manager.set_notify_callback([this]() { run_tasks(); });
+}
+
+EventLoop::~EventLoop() {
+    stop();
+    // a shared poll manager might outlive this loop
+    poll_manager.set_notify_callback(nullptr);
+}
+
+void EventLoop::post(std::function<void()> task) {
+    {
+        std::scoped_lock lock(tasks_mutex);
+        tasks.push_back(std::move(task));
+    }
+    // the tasks run within the next wakeup, together with the other pending fd events
+    poll_manager.notify();
+}
+
+void EventLoop::run(const std::function<void()>& before_poll) {
+    while (running) {
+        try {
+            before_poll();
+            poll_manager.poll(-1);
+        } catch (const std::runtime_error& e) {
+            logf_error("Shutdown loop() because of: %s", e.what());
+            // NOTE: set last, whoever sees it might release what this loop owned
+            failed = true;
+            return;
+        }
+    }
+}
+
+void EventLoop::start(std::function<void()> before_poll) {
+    thread = std::thread([this, before_poll = std::move(before_poll)]() { run(before_poll); });
+}
+
+void EventLoop::stop() {
+    running = false;
+    poll_manager.abort();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void EventLoop::run_tasks() {
+    decltype(tasks) pending_tasks;
+    {
+        std::scoped_lock lock(tasks_mutex);
+        pending_tasks.swap(tasks);
+    }
+
+    for (auto& task : pending_tasks) {
+        task();
+    }
+}
+
+} // namespace iso15118::io
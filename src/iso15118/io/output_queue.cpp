@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/io/output_queue.hpp>
+
+#include <algorithm>
+
+namespace iso15118::io {
+
+void OutputQueue::push(const uint8_t* buf, size_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    if (offset > 0 and offset == buffer.size()) {
+        // everything was consumed, start from the beginning again
+        buffer.clear();
+        offset = 0;
+    }
+
+    buffer.insert(buffer.end(), buf, buf + len);
+
+    stats.deferred_writes++;
+    stats.queued_bytes = size();
+    stats.max_queued_bytes = std::max(stats.max_queued_bytes, stats.queued_bytes);
+}
+
+void OutputQueue::consume(size_t len) {
+    offset += std::min(len, size());
+
+    if (offset == buffer.size()) {
+        // keep the capacity for the next time
+        buffer.clear();
+        offset = 0;
+    }
+
+    stats.queued_bytes = size();
+}
+
+} // namespace iso15118::io
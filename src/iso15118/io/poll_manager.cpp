@@ -2,53 +2,275 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <iso15118/io/poll_manager.hpp>
 
+#include <cerrno>
 #include <type_traits>
 #include <vector>
 
 #include <poll.h>
+#include <sys/epoll.h>
 #include <sys/eventfd.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
 #include <iso15118/detail/helper.hpp>
 
 namespace iso15118::io {
 
-static PollSet create_poll_set(const std::map<int, PollCallback>& map, int event_fd) {
+static constexpr auto EPOLL_MAX_EVENTS = 64;
+
+static PollSet create_poll_set(const std::unordered_map<int, std::unique_ptr<PollRegistration>>& map, int event_fd) {
     const auto total_size = map.size() + 1; // including event_fd
     decltype(PollSet::fds) fds(total_size);
-    decltype(PollSet::callbacks) callbacks(total_size);
+    decltype(PollSet::registrations) registrations(total_size);
 
     auto index = 0;
     for (auto it = map.begin(); it != map.end(); ++it, ++index) {
         fds[index].fd = it->first;
         fds[index].events = POLLIN;
-        callbacks[index] = &it->second;
+        if (it->second->write_interest) {
+            fds[index].events |= POLLOUT;
+        }
+        registrations[index] = it->second.get();
     }
 
     fds[index].fd = event_fd;
     fds[index].events = POLLIN;
 
-    return {std::move(fds), std::move(callbacks)};
+    return {std::move(fds), std::move(registrations)};
 }
 
-PollManager::PollManager() {
+PollManager::PollManager(PollBackend backend_) : backend(backend_) {
     event_fd = eventfd(0, 0);
     if (event_fd == -1) {
         log_and_throw("Failed to create eventfd");
     }
+
+    if (backend == PollBackend::EPOLL) {
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    }
+
+    if (epoll_fd != -1) {
+        // the event_fd is the only one without user data
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, event_fd, &event) == -1) {
+            log_and_throw("Failed to add eventfd to epoll instance");
+        }
+    } else if (backend == PollBackend::EPOLL) {
+        logf_warning("Failed to create epoll instance, falling back to poll()");
+        backend = PollBackend::POLL;
+    }
+
+    // NOTE: std::chrono::steady_clock is based on CLOCK_MONOTONIC
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd == -1) {
+        log_and_throw("Failed to create timerfd");
+    }
+
+    register_fd(timer_fd, [this]() { handle_timer_fd(); });
+
+    notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (notify_fd == -1) {
+        log_and_throw("Failed to create notify eventfd");
+    }
+
+    register_fd(notify_fd, [this]() { handle_notify_fd(); });
+}
+
+PollManager::~PollManager() {
+    close(notify_fd);
+    close(timer_fd);
+    if (epoll_fd != -1) {
+        close(epoll_fd);
+    }
+    close(event_fd);
 }
 
-void PollManager::register_fd(int fd, PollCallback& poll_callback) {
-    registered_fds.emplace(fd, poll_callback);
-    poll_set = create_poll_set(registered_fds, event_fd);
+void PollManager::register_fd(int fd, PollCallback& poll_callback, bool edge_triggered) {
+    if (registered_fds.count(fd) != 0) {
+        // replace the already existing registration
+        unregister_fd(fd);
+    }
+
+    auto registration = std::make_unique<PollRegistration>(PollRegistration{fd, poll_callback, edge_triggered});
+
+    if (backend == PollBackend::EPOLL) {
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        if (edge_triggered) {
+            event.events |= EPOLLET;
+        }
+        event.data.ptr = registration.get();
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+            const auto error_msg = adding_err_msg("Failed to add fd to epoll instance");
+            log_and_throw(error_msg.c_str());
+        }
+    }
+
+    registered_fds.emplace(fd, std::move(registration));
+    poll_set_dirty = true;
 }
 
 void PollManager::unregister_fd(int fd) {
-    registered_fds.erase(fd);
-    poll_set = create_poll_set(registered_fds, event_fd);
+    const auto it = registered_fds.find(fd);
+    if (it == registered_fds.end()) {
+        return;
+    }
+
+    if (backend == PollBackend::EPOLL) {
+        // NOTE: this might fail with EBADF, if the fd got closed before, epoll removed it already in that case
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    retire(std::move(it->second));
+    registered_fds.erase(it);
+    poll_set_dirty = true;
+}
+
+void PollManager::set_write_callback(int fd, PollCallback& write_callback) {
+    const auto it = registered_fds.find(fd);
+    if (it == registered_fds.end()) {
+        log_and_throw("Setting a write callback requires a registered fd");
+    }
+
+    it->second->write_callback = write_callback;
+}
+
+void PollManager::set_write_interest(int fd, bool enabled) {
+    const auto it = registered_fds.find(fd);
+    if (it == registered_fds.end()) {
+        return;
+    }
+
+    auto& registration = *it->second;
+    if (registration.write_interest == enabled) {
+        return;
+    }
+
+    registration.write_interest = enabled;
+
+    if (backend == PollBackend::EPOLL) {
+        update_epoll_events(registration);
+    } else {
+        poll_set_dirty = true;
+    }
+}
+
+void PollManager::update_epoll_events(PollRegistration& registration) {
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    if (registration.write_interest) {
+        event.events |= EPOLLOUT;
+    }
+    if (registration.edge_triggered) {
+        event.events |= EPOLLET;
+    }
+    event.data.ptr = &registration;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, registration.fd, &event) == -1) {
+        const auto error_msg = adding_err_msg("Failed to modify fd in epoll instance");
+        log_and_throw(error_msg.c_str());
+    }
+}
+
+void PollManager::retire(std::unique_ptr<PollRegistration> registration) {
+    // the callback might be the one which is currently running or a pending one of the current wakeup, so it can't
+    // be deleted right away
+    registration->active = false;
+    retired_registrations.push_back(std::move(registration));
+}
+
+TimerId PollManager::schedule_timer(const TimePoint& deadline, TimerCallback callback) {
+    const auto id = next_timer_id++;
+
+    timers.emplace(std::make_pair(deadline, id), std::move(callback));
+    timer_deadlines.emplace(id, deadline);
+
+    if (timers.begin()->first.second == id) {
+        // new earliest deadline
+        arm_timer_fd();
+    }
+
+    return id;
+}
+
+void PollManager::cancel_timer(TimerId id) {
+    const auto it = timer_deadlines.find(id);
+    if (it == timer_deadlines.end()) {
+        return;
+    }
+
+    timers.erase({it->second, id});
+    timer_deadlines.erase(it);
+
+    // NOTE: the timerfd is not re-armed here, an early wakeup just finds nothing to do
+}
+
+void PollManager::arm_timer_fd() {
+    struct itimerspec spec {};
+
+    if (not timers.empty()) {
+        const auto since_epoch = timers.begin()->first.first.time_since_epoch();
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+
+        // an all zero it_value would disarm the timer
+        const auto ns_at_least_one = (ns > 0) ? ns : 1;
+        spec.it_value.tv_sec = ns_at_least_one / 1000000000;
+        spec.it_value.tv_nsec = ns_at_least_one % 1000000000;
+    }
+
+    if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+        log_and_throw("Failed to arm timerfd");
+    }
+}
+
+void PollManager::handle_timer_fd() {
+    uint64_t expirations;
+    // NOTE: nothing to read, if the timer was re-armed in the meantime
+    [[maybe_unused]] const auto read_result = read(timer_fd, &expirations, sizeof(expirations));
+
+    const auto now = get_current_time_point();
+
+    while (not timers.empty() and timers.begin()->first.first <= now) {
+        auto node = timers.extract(timers.begin());
+        timer_deadlines.erase(node.key().second);
+
+        // NOTE: the callback is allowed to schedule or cancel other timers
+        node.mapped()();
+    }
+
+    arm_timer_fd();
+}
+
+void PollManager::set_notify_callback(PollCallback& notify_callback_) {
+    notify_callback = notify_callback_;
+}
+
+void PollManager::handle_notify_fd() {
+    eventfd_t tmp;
+    // NOTE: resets the counter, all notifications so far are handled by this call
+    eventfd_read(notify_fd, &tmp);
+
+    if (notify_callback) {
+        notify_callback();
+    }
 }
 
 void PollManager::poll(int timeout_ms) {
+    if (backend == PollBackend::EPOLL) {
+        poll_with_epoll(timeout_ms);
+    } else {
+        poll_with_poll(timeout_ms);
+    }
+
+    retired_registrations.clear();
+}
+
+void PollManager::poll_with_poll(int timeout_ms) {
+    if (poll_set_dirty) {
+        poll_set = create_poll_set(registered_fds, event_fd);
+        poll_set_dirty = false;
+    }
 
     auto& pollfds = poll_set.fds;
 
@@ -74,8 +296,44 @@ void PollManager::poll(int timeout_ms) {
 
     // check fds
     for (std::size_t i = 0; i < pollfds.size() - 1; ++i) {
-        if (pollfds[i].revents & POLLIN) {
-            (*poll_set.callbacks[i])();
+        const auto registration = poll_set.registrations[i];
+        if ((pollfds[i].revents & (POLLIN | POLLHUP | POLLERR)) and registration->active) {
+            registration->callback();
+        }
+        if ((pollfds[i].revents & POLLOUT) and registration->active and registration->write_interest) {
+            registration->write_callback();
+        }
+    }
+}
+
+void PollManager::poll_with_epoll(int timeout_ms) {
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+
+    const auto ret = epoll_wait(epoll_fd, events, EPOLL_MAX_EVENTS, timeout_ms);
+
+    if (ret == -1) {
+        if (errno == EINTR) {
+            return;
+        }
+        log_and_throw("Epoll wait failed\n");
+    }
+
+    // NOTE: other than with the poll() backend, the remaining events are still dispatched after an abort, because
+    // edge triggered events would get lost otherwise
+    for (auto i = 0; i < ret; ++i) {
+        const auto registration = static_cast<PollRegistration*>(events[i].data.ptr);
+
+        if (registration == nullptr) {
+            eventfd_t tmp;
+            eventfd_read(event_fd, &tmp);
+            continue;
+        }
+
+        if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) and registration->active) {
+            registration->callback();
+        }
+        if ((events[i].events & EPOLLOUT) and registration->active and registration->write_interest) {
+            registration->write_callback();
         }
     }
 }
@@ -84,4 +342,8 @@ void PollManager::abort() {
     eventfd_write(event_fd, 1);
 }
 
+void PollManager::notify() {
+    eventfd_write(notify_fd, 1);
+}
+
 } // namespace iso15118::io
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/detail/io/session_ticket_keys.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <openssl/rand.h>
+
+#include <iso15118/detail/helper.hpp>
+
+namespace iso15118::io {
+
+namespace {
+
+int64_t to_seconds(SessionTicketKeyStore::Clock::time_point time_point) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time_point.time_since_epoch()).count();
+}
+
+SessionTicketKey create_key(int64_t now) {
+    SessionTicketKey key;
+
+    if (RAND_bytes(key.name.data(), key.name.size()) != 1 or
+        RAND_bytes(key.aes_key.data(), key.aes_key.size()) != 1 or
+        RAND_bytes(key.hmac_key.data(), key.hmac_key.size()) != 1) {
+        throw std::runtime_error("Failed to generate a session ticket key");
+    }
+
+    key.created_at = now;
+
+    return key;
+}
+
+void write_key(std::ostream& out, const SessionTicketKey& key) {
+    out.write(reinterpret_cast<const char*>(key.name.data()), key.name.size());
+    out.write(reinterpret_cast<const char*>(key.aes_key.data()), key.aes_key.size());
+    out.write(reinterpret_cast<const char*>(key.hmac_key.data()), key.hmac_key.size());
+    out.write(reinterpret_cast<const char*>(&key.created_at), sizeof(key.created_at));
+}
+
+bool read_key(std::istream& in, SessionTicketKey& key) {
+    in.read(reinterpret_cast<char*>(key.name.data()), key.name.size());
+    in.read(reinterpret_cast<char*>(key.aes_key.data()), key.aes_key.size());
+    in.read(reinterpret_cast<char*>(key.hmac_key.data()), key.hmac_key.size());
+    in.read(reinterpret_cast<char*>(&key.created_at), sizeof(key.created_at));
+    return static_cast<bool>(in);
+}
+
+} // namespace
+
+SessionTicketKeyStore::SessionTicketKeyStore(std::chrono::seconds rotation_interval_, std::filesystem::path file_) :
+    rotation_interval(rotation_interval_.count()), file(std::move(file_)) {
+
+    const auto now = to_seconds(Clock::now());
+
+    if (not file.empty() and load()) {
+        rotate_if_needed(now);
+        return;
+    }
+
+    current = create_key(now);
+    save();
+}
+
+SessionTicketKey SessionTicketKeyStore::get_encryption_key(Clock::time_point now) {
+    std::scoped_lock lock(mutex);
+    rotate_if_needed(to_seconds(now));
+    return current;
+}
+
+std::optional<SessionTicketKeyLookup> SessionTicketKeyStore::find_decryption_key(const uint8_t* name,
+                                                                                 Clock::time_point now) {
+    std::scoped_lock lock(mutex);
+    rotate_if_needed(to_seconds(now));
+
+    const auto matches = [name](const SessionTicketKey& key) {
+        return std::equal(key.name.begin(), key.name.end(), name);
+    };
+
+    if (matches(current)) {
+        return SessionTicketKeyLookup{current, false};
+    }
+
+    if (previous and matches(*previous)) {
+        return SessionTicketKeyLookup{*previous, true};
+    }
+
+    return std::nullopt;
+}
+
+void SessionTicketKeyStore::rotate_if_needed(int64_t now) {
+    if (rotation_interval <= 0) {
+        return;
+    }
+
+    bool rotated{false};
+
+    if (previous and now - previous->created_at >= 2 * rotation_interval) {
+        // all tickets of the previous key are expired
+        previous.reset();
+        rotated = true;
+    }
+
+    if (now - current.created_at >= rotation_interval) {
+        if (now - current.created_at < 2 * rotation_interval) {
+            previous = current;
+        } else {
+            previous.reset();
+        }
+        current = create_key(now);
+        rotated = true;
+    }
+
+    if (rotated) {
+        save();
+    }
+}
+
+bool SessionTicketKeyStore::load() {
+    std::ifstream in(file, std::ios::binary);
+    if (not in) {
+        return false;
+    }
+
+    if (not read_key(in, current)) {
+        logf_warning("Invalid session ticket key file %s, creating new keys", file.c_str());
+        return false;
+    }
+
+    SessionTicketKey key;
+    if (read_key(in, key)) {
+        previous = key;
+    }
+
+    return true;
+}
+
+void SessionTicketKeyStore::save() const {
+    if (file.empty()) {
+        return;
+    }
+
+    // NOTE: the keys are written to a temporary file first, so readers never see a partially written one
+    auto tmp_file = file;
+    tmp_file += ".tmp";
+
+    std::ostringstream out;
+    write_key(out, current);
+    if (previous) {
+        write_key(out, *previous);
+    }
+    const auto keys = out.str();
+
+    // NOTE: created with restricted permissions right away, so no other process can open it in between. A leftover
+    // temporary file is removed first, because opening an existing file would keep its permissions.
+    ::unlink(tmp_file.c_str());
+    const auto fd = ::open(tmp_file.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd == -1) {
+        logf_error("Failed to write the session ticket keys to %s: %s", tmp_file.c_str(), strerror(errno));
+        return;
+    }
+
+    std::size_t offset = 0;
+    while (offset < keys.size()) {
+        const auto result = ::write(fd, keys.data() + offset, keys.size() - offset);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logf_error("Failed to write the session ticket keys to %s: %s", tmp_file.c_str(), strerror(errno));
+            ::close(fd);
+            ::unlink(tmp_file.c_str());
+            return;
+        }
+        offset += result;
+    }
+
+    ::close(fd);
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_file, file, ec);
+    if (ec) {
+        logf_error("Failed to store the session ticket keys to %s: %s", file.c_str(), ec.message().c_str());
+    }
+}
+
+} // namespace iso15118::io
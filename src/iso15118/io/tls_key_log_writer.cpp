@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/detail/io/tls_key_log_writer.hpp>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <iso15118/detail/helper.hpp>
+#include <iso15118/io/sdp_server.hpp>
+
+namespace iso15118::io {
+
+TlsKeyLogWriter::TlsKeyLogWriter(const std::filesystem::path& file) {
+    fd = ::open(file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (fd == -1) {
+        logf_error("Failed to open the TLS key log file %s: %s", file.c_str(), strerror(errno));
+    }
+
+    thread = std::thread([this]() { run(); });
+}
+
+TlsKeyLogWriter::~TlsKeyLogWriter() {
+    {
+        std::scoped_lock lock(mutex);
+        running = false;
+    }
+    cv.notify_one();
+
+    thread.join();
+
+    if (fd != -1) {
+        ::close(fd);
+    }
+}
+
+void TlsKeyLogWriter::push(const char* line, std::shared_ptr<TlsKeyLoggingServer> server) {
+    {
+        std::scoped_lock lock(mutex);
+        pending.push_back({line, std::move(server)});
+    }
+    cv.notify_one();
+}
+
+void TlsKeyLogWriter::run() {
+    std::vector<Entry> entries;
+
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [this]() { return not running or not pending.empty(); });
+
+            if (pending.empty()) {
+                // only left, once all pushed lines are written
+                return;
+            }
+
+            // all lines pushed meanwhile are written at once
+            entries.clear();
+            entries.swap(pending);
+        }
+
+        write(entries);
+    }
+}
+
+void TlsKeyLogWriter::write(std::vector<Entry>& entries) {
+    std::string buffer;
+
+    for (auto& entry : entries) {
+        if (entry.server) {
+            logf_info("TLS Handshake keys on port %u: %s", entry.server->get_port(), entry.line.c_str());
+
+            if (entry.server->get_fd() != -1) {
+                const auto result = entry.server->send(entry.line.c_str());
+                if (not cmp_equal(result, entry.line.size())) {
+                    const auto error_msg = adding_err_msg("key_logging_server send() failed");
+                    logf_error(error_msg.c_str());
+                }
+            }
+
+            // the server is closed as soon as its last line has been sent
+            entry.server.reset();
+        } else {
+            logf_info("TLS Handshake keys: %s", entry.line.c_str());
+        }
+
+        buffer += entry.line;
+        buffer += '\n';
+    }
+
+    if (fd == -1) {
+        return;
+    }
+
+    std::size_t offset = 0;
+    while (offset < buffer.size()) {
+        const auto result = ::write(fd, buffer.data() + offset, buffer.size() - offset);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logf_error("Failed to write the TLS key log file: %s", strerror(errno));
+            return;
+        }
+        offset += result;
+    }
+}
+
+} // namespace iso15118::io
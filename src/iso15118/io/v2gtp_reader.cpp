@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/io/v2gtp_reader.hpp>
+
+#include <cstring>
+
+#include <endian.h>
+
+#include <iso15118/io/sdp_packet.hpp>
+
+namespace iso15118::io {
+
+void V2gtpReader::compact() {
+    if (begin == 0) {
+        return;
+    }
+
+    const auto buffered_bytes = end - begin;
+    if (buffered_bytes > 0) {
+        std::memmove(buffer, buffer + begin, buffered_bytes);
+    }
+
+    begin = 0;
+    end = buffered_bytes;
+}
+
+bool V2gtpReader::fill(IConnection& connection) {
+    compact();
+
+    const auto read_result = connection.read(buffer + end, sizeof(buffer) - end);
+    end += read_result.bytes_read;
+
+    return read_result.would_block;
+}
+
+std::optional<V2gtpFrame> V2gtpReader::next_frame() {
+    if (state != State::OK) {
+        return std::nullopt;
+    }
+
+    const auto buffered_bytes = end - begin;
+    if (buffered_bytes < SdpPacket::V2GTP_HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    const auto header = buffer + begin;
+
+    if ((header[0] != SDP_PROTOCOL_VERSION) or (header[1] != SDP_INVERSE_PROTOCOL_VERSION)) {
+        state = State::INVALID_HEADER;
+        return std::nullopt;
+    }
+
+    uint32_t tmp32;
+    std::memcpy(&tmp32, header + 4, sizeof(tmp32));
+    const auto payload_length = be32toh(tmp32);
+
+    if (payload_length > MAX_FRAME_SIZE - SdpPacket::V2GTP_HEADER_SIZE) {
+        state = State::PAYLOAD_TO_LONG;
+        return std::nullopt;
+    }
+
+    const auto frame_length = payload_length + SdpPacket::V2GTP_HEADER_SIZE;
+    if (buffered_bytes < frame_length) {
+        // frame not complete yet
+        return std::nullopt;
+    }
+
+    uint16_t tmp16;
+    std::memcpy(&tmp16, header + 2, sizeof(tmp16));
+
+    begin += frame_length;
+
+    return V2gtpFrame{static_cast<v2gtp::PayloadType>(be16toh(tmp16)),
+                      {header + SdpPacket::V2GTP_HEADER_SIZE, payload_length}};
+}
+
+} // namespace iso15118::io
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/io/worker_pool.hpp>
+
+#include <stdexcept>
+
+namespace iso15118::io {
+
+WorkerPool::WorkerPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        throw std::invalid_argument("A worker pool needs at least one thread");
+    }
+
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([this]() { run(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::scoped_lock lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+std::future<void> WorkerPool::post(std::function<void()> task) {
+    std::packaged_task<void()> packaged_task(std::move(task));
+    auto result = packaged_task.get_future();
+
+    {
+        std::scoped_lock lock(mutex);
+        tasks.push_back(std::move(packaged_task));
+    }
+    cv.notify_one();
+
+    return result;
+}
+
+void WorkerPool::run() {
+    while (true) {
+        std::packaged_task<void()> task;
+
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [this]() { return not running or not tasks.empty(); });
+
+            if (tasks.empty()) {
+                // only left, once all posted tasks are done
+                return;
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+} // namespace iso15118::io
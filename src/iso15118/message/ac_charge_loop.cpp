@@ -2,8 +2,10 @@
 // Copyright 2024 Pionix GmbH and Contributors to EVerest
 #include <iso15118/message/ac_charge_loop.hpp>
 
+#include <algorithm>
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_AC_Decoder.h>
@@ -118,6 +120,22 @@ void convert(const struct iso20_ac_BPT_Dynamic_AC_CLReqControlModeType& in,
     CB2CPP_CONVERT_IF_USED(in.EVMinimumV2XEnergyRequest, out.min_v2x_energy_request);
 }
 
+static void convert_control_mode(const struct iso20_ac_AC_ChargeLoopReqType& in,
+                                 AC_ChargeLoopRequestView::ControlMode& out) {
+    if (in.Scheduled_AC_CLReqControlMode_isUsed) {
+        convert(in.Scheduled_AC_CLReqControlMode, out.emplace<datatypes::Scheduled_AC_CLReqControlMode>());
+    } else if (in.BPT_Scheduled_AC_CLReqControlMode_isUsed) {
+        convert(in.BPT_Scheduled_AC_CLReqControlMode, out.emplace<datatypes::BPT_Scheduled_AC_CLReqControlMode>());
+    } else if (in.Dynamic_AC_CLReqControlMode_isUsed) {
+        convert(in.Dynamic_AC_CLReqControlMode, out.emplace<datatypes::Dynamic_AC_CLReqControlMode>());
+    } else if (in.BPT_Dynamic_AC_CLReqControlMode_isUsed) {
+        convert(in.BPT_Dynamic_AC_CLReqControlMode, out.emplace<datatypes::BPT_Dynamic_AC_CLReqControlMode>());
+    } else {
+        // should not happen
+        assert(false);
+    }
+}
+
 template <> void convert(const struct iso20_ac_AC_ChargeLoopReqType& in, AC_ChargeLoopRequest& out) {
     convert(in.Header, out.header);
 
@@ -125,20 +143,95 @@ template <> void convert(const struct iso20_ac_AC_ChargeLoopReqType& in, AC_Char
 
     out.meter_info_requested = in.MeterInfoRequested;
 
-    if (in.Scheduled_AC_CLReqControlMode_isUsed) {
-        convert(in.Scheduled_AC_CLReqControlMode, out.control_mode.emplace<datatypes::Scheduled_AC_CLReqControlMode>());
-    } else if (in.BPT_Scheduled_AC_CLReqControlMode_isUsed) {
-        convert(in.BPT_Scheduled_AC_CLReqControlMode,
-                out.control_mode.emplace<datatypes::BPT_Scheduled_AC_CLReqControlMode>());
-    } else if (in.Dynamic_AC_CLReqControlMode_isUsed) {
-        convert(in.Dynamic_AC_CLReqControlMode, out.control_mode.emplace<datatypes::Dynamic_AC_CLReqControlMode>());
-    } else if (in.BPT_Dynamic_AC_CLReqControlMode_isUsed) {
-        convert(in.BPT_Dynamic_AC_CLReqControlMode,
-                out.control_mode.emplace<datatypes::BPT_Dynamic_AC_CLReqControlMode>());
+    convert_control_mode(in, out.control_mode);
+}
+
+AC_ChargeLoopRequestView::AC_ChargeLoopRequestView(const AC_ChargeLoopRequest& message_) : message(&message_) {
+}
+
+AC_ChargeLoopRequestView::AC_ChargeLoopRequestView(const struct iso20_ac_AC_ChargeLoopReqType& document_) :
+    document(&document_) {
+}
+
+Header AC_ChargeLoopRequestView::get_header() const {
+    if (message) {
+        return message->header;
+    }
+
+    Header header;
+    convert(document->Header, header);
+    return header;
+}
+
+datatypes::SessionId AC_ChargeLoopRequestView::get_session_id() const {
+    if (message) {
+        return message->header.session_id;
+    }
+
+    datatypes::SessionId session_id{};
+    std::copy(document->Header.SessionID.bytes, document->Header.SessionID.bytes + document->Header.SessionID.bytesLen,
+              session_id.begin());
+    return session_id;
+}
+
+std::optional<datatypes::DisplayParameters> AC_ChargeLoopRequestView::get_display_parameters() const {
+    if (message) {
+        return message->display_parameters;
+    }
+
+    std::optional<datatypes::DisplayParameters> display_parameters;
+    CB2CPP_CONVERT_IF_USED(document->DisplayParameters, display_parameters);
+    return display_parameters;
+}
+
+bool AC_ChargeLoopRequestView::get_meter_info_requested() const {
+    if (message) {
+        return message->meter_info_requested;
+    }
+
+    return document->MeterInfoRequested;
+}
+
+template <typename ControlModeType> bool AC_ChargeLoopRequestView::holds_control_mode() const {
+    if (message) {
+        return std::holds_alternative<ControlModeType>(message->control_mode);
+    }
+
+    if constexpr (std::is_same_v<ControlModeType, datatypes::Scheduled_AC_CLReqControlMode>) {
+        return document->Scheduled_AC_CLReqControlMode_isUsed;
+    } else if constexpr (std::is_same_v<ControlModeType, datatypes::BPT_Scheduled_AC_CLReqControlMode>) {
+        return document->BPT_Scheduled_AC_CLReqControlMode_isUsed;
+    } else if constexpr (std::is_same_v<ControlModeType, datatypes::Dynamic_AC_CLReqControlMode>) {
+        return document->Dynamic_AC_CLReqControlMode_isUsed;
     } else {
-        // should not happen
-        assert(false);
+        static_assert(std::is_same_v<ControlModeType, datatypes::BPT_Dynamic_AC_CLReqControlMode>);
+        return document->BPT_Dynamic_AC_CLReqControlMode_isUsed;
+    }
+}
+
+template bool AC_ChargeLoopRequestView::holds_control_mode<datatypes::Scheduled_AC_CLReqControlMode>() const;
+template bool AC_ChargeLoopRequestView::holds_control_mode<datatypes::BPT_Scheduled_AC_CLReqControlMode>() const;
+template bool AC_ChargeLoopRequestView::holds_control_mode<datatypes::Dynamic_AC_CLReqControlMode>() const;
+template bool AC_ChargeLoopRequestView::holds_control_mode<datatypes::BPT_Dynamic_AC_CLReqControlMode>() const;
+
+AC_ChargeLoopRequestView::ControlMode AC_ChargeLoopRequestView::get_control_mode() const {
+    if (message) {
+        return message->control_mode;
+    }
+
+    ControlMode control_mode;
+    convert_control_mode(*document, control_mode);
+    return control_mode;
+}
+
+AC_ChargeLoopRequestView::Message AC_ChargeLoopRequestView::get_message() const {
+    if (message) {
+        return *message;
     }
+
+    Message converted;
+    convert(*document, converted);
+    return converted;
 }
 
 template <> void insert_type(VariantAccess& va, const struct iso20_ac_AC_ChargeLoopReqType& in) {
@@ -392,8 +485,8 @@ template <> void convert(const AC_ChargeLoopResponse& in, struct iso20_ac_AC_Cha
     std::visit(ControlModeVisitor(out), in.control_mode);
 }
 
-template <> int serialize_to_exi(const AC_ChargeLoopResponse& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+template <> int serialize_to_exi(const AC_ChargeLoopResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().ac;
     init_iso20_ac_exiDocument(&doc);
 
     CB_SET_USED(doc.AC_ChargeLoopRes);
@@ -403,8 +496,8 @@ template <> int serialize_to_exi(const AC_ChargeLoopResponse& in, exi_bitstream_
     return encode_iso20_ac_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const AC_ChargeLoopResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const AC_ChargeLoopResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing an ACChargeLoopResponse (EVSEside)
 
@@ -526,8 +619,8 @@ template <> void convert(const AC_ChargeLoopRequest& in, struct iso20_ac_AC_Char
     std::visit(ModeRequestVisitor(out), in.control_mode);
 }
 
-template <> int serialize_to_exi(const AC_ChargeLoopRequest& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+template <> int serialize_to_exi(const AC_ChargeLoopRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().ac;
     init_iso20_ac_exiDocument(&doc);
 
     CB_SET_USED(doc.AC_ChargeLoopReq);
@@ -537,8 +630,8 @@ template <> int serialize_to_exi(const AC_ChargeLoopRequest& in, exi_bitstream_t
     return encode_iso20_ac_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const AC_ChargeLoopRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const AC_ChargeLoopRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing an ACChargeLoopRequest (EVside)
 
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_AC_Decoder.h>
@@ -157,8 +158,9 @@ void convert(const AC_ChargeParameterDiscoveryResponse& in, struct iso20_ac_AC_C
     std::visit(ModeResponseVisitor(out), in.transfer_mode);
 }
 
-template <> int serialize_to_exi(const AC_ChargeParameterDiscoveryResponse& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+template <>
+int serialize_to_exi(const AC_ChargeParameterDiscoveryResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().ac;
 
     init_iso20_ac_exiDocument(&doc);
 
@@ -168,8 +170,9 @@ template <> int serialize_to_exi(const AC_ChargeParameterDiscoveryResponse& in,
 
     return encode_iso20_ac_exiDocument(&out, &doc);
 }
-template <> size_t serialize(const AC_ChargeParameterDiscoveryResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const AC_ChargeParameterDiscoveryResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing an ACChargeParameterResponse (EVSEside)
 
@@ -221,8 +224,9 @@ void convert(const AC_ChargeParameterDiscoveryRequest& in, struct iso20_ac_AC_Ch
     std::visit(ModeRequestVisitor(out), in.transfer_mode);
 }
 
-template <> int serialize_to_exi(const AC_ChargeParameterDiscoveryRequest& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+template <>
+int serialize_to_exi(const AC_ChargeParameterDiscoveryRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().ac;
 
     init_iso20_ac_exiDocument(&doc);
 
@@ -232,9 +236,10 @@ template <> int serialize_to_exi(const AC_ChargeParameterDiscoveryRequest& in, e
 
     return encode_iso20_ac_exiDocument(&out, &doc);
 }
-template <> size_t serialize(const AC_ChargeParameterDiscoveryRequest& in, const io::StreamOutputView& out) {
+template <>
+size_t serialize(const AC_ChargeParameterDiscoveryRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
 
-    auto rv = serialize_helper(in, out);
+    auto rv = serialize_helper(in, out, codec);
 
     return rv;
 }
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -88,8 +89,8 @@ template <> void insert_type(VariantAccess& va, const struct iso20_Authorization
     va.insert_type<AuthorizationSetupResponse>(in);
 };
 
-template <> int serialize_to_exi(const AuthorizationSetupResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const AuthorizationSetupResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.AuthorizationSetupRes);
@@ -99,8 +100,8 @@ template <> int serialize_to_exi(const AuthorizationSetupResponse& in, exi_bitst
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> int serialize_to_exi(const AuthorizationSetupRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const AuthorizationSetupRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.AuthorizationSetupReq);
@@ -110,12 +111,14 @@ template <> int serialize_to_exi(const AuthorizationSetupRequest& in, exi_bitstr
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const AuthorizationSetupResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const AuthorizationSetupResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
-template <> size_t serialize(const AuthorizationSetupRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const AuthorizationSetupRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/detail/codec_context.hpp>
+
+namespace iso15118::message_20 {
+
+CodecContext::CodecContext() : documents(std::make_unique<Documents>()) {
+}
+
+CodecContext::~CodecContext() = default;
+
+} // namespace iso15118::message_20
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <cmath>
+#include <iterator>
+#include <limits>
 
 #include <iso15118/message/common_types.hpp>
 
@@ -155,21 +157,91 @@ template <> void convert(const struct iso20_PowerScheduleEntryType& in, datatype
 
 namespace datatypes {
 
+// NOTE: powers of ten up to 10^22 are exact in double precision, the larger ones are correctly rounded literals
+static constexpr double POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+    1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31, 1e32, 1e33,
+    1e34, 1e35, 1e36, 1e37, 1e38, 1e39, 1e40, 1e41, 1e42, 1e43, 1e44, 1e45, 1e46, 1e47, 1e48, 1e49, 1e50,
+};
+
+static constexpr int MAX_POW10 = std::size(POW10) - 1;
+
+// value * 10^exponent, dividing for negative exponents keeps 10^-n (which is not representable) out of the result
+static double scale_by_pow10(double value, int exponent) {
+    if (exponent >= 0) {
+        return value * POW10[exponent];
+    }
+    return value / POW10[-exponent];
+}
+
+// number of significant decimal digits of the value of a converted RationalNumber
+static constexpr int SIGNIFICANT_DIGITS = 4;
+static constexpr int16_t MIN_NORMALIZED_VALUE = 1000;
+static constexpr int16_t MAX_NORMALIZED_VALUE = 9999;
+
 float from_RationalNumber(const RationalNumber& in) {
-    return in.value * pow(10, in.exponent);
+    if (in.value == 0) {
+        return 0.0f;
+    }
+
+    // |value| >= 1, so anything above is out of range for a float and anything below rounds to zero
+    if (in.exponent > MAX_POW10) {
+        return in.value > 0 ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+    } else if (in.exponent < -MAX_POW10) {
+        return 0.0f;
+    }
+
+    return static_cast<float>(scale_by_pow10(in.value, in.exponent));
 }
 
 RationalNumber from_float(float in) {
-    RationalNumber out;
-    if (in == 0.0) {
-        out.exponent = 0;
-        out.value = 0;
-        return out;
+    if (in == 0.0f or std::isnan(in)) {
+        return {0, 0};
+    }
+
+    if (std::isinf(in)) {
+        return {in > 0 ? std::numeric_limits<int16_t>::max() : std::numeric_limits<int16_t>::min(),
+                std::numeric_limits<int8_t>::max()};
+    }
+
+    const double abs_in = std::fabs(in);
+
+    // floor(log10(abs_in)) estimated from the binary exponent (log10(2) ~ 1233 / 2^12), then corrected by comparing
+    // with the table, which takes at most one step. 2^(binary_exponent - 1) <= abs_in < 2^binary_exponent
+    int binary_exponent;
+    std::frexp(abs_in, &binary_exponent);
+    const auto scaled_exponent = (binary_exponent - 1) * 1233;
+    int decimal_exponent = scaled_exponent >= 0 ? scaled_exponent / 4096 : -((-scaled_exponent + 4095) / 4096);
+
+    while (scale_by_pow10(1.0, decimal_exponent + 1) <= abs_in) {
+        ++decimal_exponent;
+    }
+    while (abs_in < scale_by_pow10(1.0, decimal_exponent)) {
+        --decimal_exponent;
+    }
+
+    int exponent = decimal_exponent - (SIGNIFICANT_DIGITS - 1);
+    auto value = static_cast<int32_t>(scale_by_pow10(abs_in, -exponent) + 0.5);
+
+    if (value > MAX_NORMALIZED_VALUE) {
+        // rounded up to the next power of ten
+        value = MIN_NORMALIZED_VALUE;
+        ++exponent;
+    }
+
+    return {static_cast<int16_t>(in < 0 ? -value : value), static_cast<int8_t>(exponent)};
+}
+
+void from_RationalNumber(const RationalNumber* in, float* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = from_RationalNumber(in[i]);
+    }
+}
+
+void from_float(const float* in, RationalNumber* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = from_float(in[i]);
     }
-    out.exponent = static_cast<int8_t>(floor(log10(fabs(in))));
-    out.exponent -= 3; // add 3 digits of precision
-    out.value = static_cast<int16_t>(in * pow(10, -out.exponent));
-    return out;
 }
 
 std::string from_Protocol(const Protocol& in) {
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -32,8 +33,8 @@ template <> void convert(const DC_CableCheckResponse& in, struct iso20_dc_DC_Cab
     cb_convert_enum(in.processing, out.EVSEProcessing);
 }
 
-template <> int serialize_to_exi(const DC_CableCheckResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_CableCheckResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_CableCheckRes);
@@ -43,8 +44,8 @@ template <> int serialize_to_exi(const DC_CableCheckResponse& in, exi_bitstream_
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_CableCheckResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const DC_CableCheckResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 template <> void insert_type(VariantAccess& va, const struct iso20_dc_DC_CableCheckReqType& in) {
@@ -56,8 +57,8 @@ template <> void convert(const DC_CableCheckRequest& in, iso20_dc_DC_CableCheckR
     convert(in.header, out.Header);
 }
 
-template <> int serialize_to_exi(const DC_CableCheckRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_CableCheckRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_CableCheckReq);
@@ -67,8 +68,8 @@ template <> int serialize_to_exi(const DC_CableCheckRequest& in, exi_bitstream_t
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_CableCheckRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const DC_CableCheckRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
@@ -2,8 +2,10 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <iso15118/message/dc_charge_loop.hpp>
 
+#include <algorithm>
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Decoder.h>
@@ -94,6 +96,22 @@ void convert(const struct iso20_dc_BPT_Dynamic_DC_CLReqControlModeType& in,
     CB2CPP_CONVERT_IF_USED(in.EVMinimumV2XEnergyRequest, out.min_v2x_energy_request);
 }
 
+static void convert_control_mode(const struct iso20_dc_DC_ChargeLoopReqType& in,
+                                 DC_ChargeLoopRequestView::ControlMode& out) {
+    if (in.Scheduled_DC_CLReqControlMode_isUsed) {
+        convert(in.Scheduled_DC_CLReqControlMode, out.emplace<datatypes::Scheduled_DC_CLReqControlMode>());
+    } else if (in.BPT_Scheduled_DC_CLReqControlMode_isUsed) {
+        convert(in.BPT_Scheduled_DC_CLReqControlMode, out.emplace<datatypes::BPT_Scheduled_DC_CLReqControlMode>());
+    } else if (in.Dynamic_DC_CLReqControlMode_isUsed) {
+        convert(in.Dynamic_DC_CLReqControlMode, out.emplace<datatypes::Dynamic_DC_CLReqControlMode>());
+    } else if (in.BPT_Dynamic_DC_CLReqControlMode_isUsed) {
+        convert(in.BPT_Dynamic_DC_CLReqControlMode, out.emplace<datatypes::BPT_Dynamic_DC_CLReqControlMode>());
+    } else {
+        // should not happen
+        assert(false);
+    }
+}
+
 template <> void convert(const struct iso20_dc_DC_ChargeLoopReqType& in, DC_ChargeLoopRequest& out) {
     convert(in.Header, out.header);
 
@@ -103,21 +121,106 @@ template <> void convert(const struct iso20_dc_DC_ChargeLoopReqType& in, DC_Char
 
     convert(in.EVPresentVoltage, out.present_voltage);
 
-    if (in.Scheduled_DC_CLReqControlMode_isUsed) {
-        convert(in.Scheduled_DC_CLReqControlMode, out.control_mode.emplace<datatypes::Scheduled_DC_CLReqControlMode>());
-    } else if (in.BPT_Scheduled_DC_CLReqControlMode_isUsed) {
-        convert(in.BPT_Scheduled_DC_CLReqControlMode,
-                out.control_mode.emplace<datatypes::BPT_Scheduled_DC_CLReqControlMode>());
-    } else if (in.Dynamic_DC_CLReqControlMode_isUsed) {
-        convert(in.Dynamic_DC_CLReqControlMode, out.control_mode.emplace<datatypes::Dynamic_DC_CLReqControlMode>());
-    } else if (in.BPT_Dynamic_DC_CLReqControlMode_isUsed) {
-        convert(in.BPT_Dynamic_DC_CLReqControlMode,
-                out.control_mode.emplace<datatypes::BPT_Dynamic_DC_CLReqControlMode>());
+    convert_control_mode(in, out.control_mode);
+}
+
+DC_ChargeLoopRequestView::DC_ChargeLoopRequestView(const DC_ChargeLoopRequest& message_) : message(&message_) {
+}
+
+DC_ChargeLoopRequestView::DC_ChargeLoopRequestView(const struct iso20_dc_DC_ChargeLoopReqType& document_) :
+    document(&document_) {
+}
+
+Header DC_ChargeLoopRequestView::get_header() const {
+    if (message) {
+        return message->header;
+    }
+
+    Header header;
+    convert(document->Header, header);
+    return header;
+}
+
+datatypes::SessionId DC_ChargeLoopRequestView::get_session_id() const {
+    if (message) {
+        return message->header.session_id;
+    }
+
+    datatypes::SessionId session_id{};
+    std::copy(document->Header.SessionID.bytes, document->Header.SessionID.bytes + document->Header.SessionID.bytesLen,
+              session_id.begin());
+    return session_id;
+}
+
+std::optional<datatypes::DisplayParameters> DC_ChargeLoopRequestView::get_display_parameters() const {
+    if (message) {
+        return message->display_parameters;
+    }
+
+    std::optional<datatypes::DisplayParameters> display_parameters;
+    CB2CPP_CONVERT_IF_USED(document->DisplayParameters, display_parameters);
+    return display_parameters;
+}
+
+bool DC_ChargeLoopRequestView::get_meter_info_requested() const {
+    if (message) {
+        return message->meter_info_requested;
+    }
+
+    return document->MeterInfoRequested;
+}
+
+datatypes::RationalNumber DC_ChargeLoopRequestView::get_present_voltage() const {
+    if (message) {
+        return message->present_voltage;
+    }
+
+    datatypes::RationalNumber present_voltage;
+    convert(document->EVPresentVoltage, present_voltage);
+    return present_voltage;
+}
+
+template <typename ControlModeType> bool DC_ChargeLoopRequestView::holds_control_mode() const {
+    if (message) {
+        return std::holds_alternative<ControlModeType>(message->control_mode);
+    }
+
+    if constexpr (std::is_same_v<ControlModeType, datatypes::Scheduled_DC_CLReqControlMode>) {
+        return document->Scheduled_DC_CLReqControlMode_isUsed;
+    } else if constexpr (std::is_same_v<ControlModeType, datatypes::BPT_Scheduled_DC_CLReqControlMode>) {
+        return document->BPT_Scheduled_DC_CLReqControlMode_isUsed;
+    } else if constexpr (std::is_same_v<ControlModeType, datatypes::Dynamic_DC_CLReqControlMode>) {
+        return document->Dynamic_DC_CLReqControlMode_isUsed;
     } else {
-        // should not happen
-        assert(false);
+        static_assert(std::is_same_v<ControlModeType, datatypes::BPT_Dynamic_DC_CLReqControlMode>);
+        return document->BPT_Dynamic_DC_CLReqControlMode_isUsed;
     }
 }
+
+template bool DC_ChargeLoopRequestView::holds_control_mode<datatypes::Scheduled_DC_CLReqControlMode>() const;
+template bool DC_ChargeLoopRequestView::holds_control_mode<datatypes::BPT_Scheduled_DC_CLReqControlMode>() const;
+template bool DC_ChargeLoopRequestView::holds_control_mode<datatypes::Dynamic_DC_CLReqControlMode>() const;
+template bool DC_ChargeLoopRequestView::holds_control_mode<datatypes::BPT_Dynamic_DC_CLReqControlMode>() const;
+
+DC_ChargeLoopRequestView::ControlMode DC_ChargeLoopRequestView::get_control_mode() const {
+    if (message) {
+        return message->control_mode;
+    }
+
+    ControlMode control_mode;
+    convert_control_mode(*document, control_mode);
+    return control_mode;
+}
+
+DC_ChargeLoopRequestView::Message DC_ChargeLoopRequestView::get_message() const {
+    if (message) {
+        return *message;
+    }
+
+    Message converted;
+    convert(*document, converted);
+    return converted;
+}
 // End DC_ChargeLoopRequest Deserialization (EVSEside)
 
 // Begin DC_ChargeLoopResponse Deserialization (EVside)
@@ -357,8 +460,8 @@ template <> void convert(const DC_ChargeLoopResponse& in, struct iso20_dc_DC_Cha
     std::visit(ControlModeVisitor(out), in.control_mode);
 }
 
-template <> int serialize_to_exi(const DC_ChargeLoopResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_ChargeLoopResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_ChargeLoopRes);
@@ -368,8 +471,8 @@ template <> int serialize_to_exi(const DC_ChargeLoopResponse& in, exi_bitstream_
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_ChargeLoopResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const DC_ChargeLoopResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End DC_ChargeLoopResponse Serialization (EVSEside)
 
@@ -495,8 +598,8 @@ template <> void convert(const DC_ChargeLoopRequest& in, iso20_dc_DC_ChargeLoopR
     convert(in.header, out.Header);
 }
 
-template <> int serialize_to_exi(const DC_ChargeLoopRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_ChargeLoopRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_ChargeLoopReq);
@@ -506,8 +609,8 @@ template <> int serialize_to_exi(const DC_ChargeLoopRequest& in, exi_bitstream_t
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_ChargeLoopRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const DC_ChargeLoopRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 // End DC_ChargeLoopRequest Serialization (EVside)
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -137,8 +138,9 @@ void convert(const DC_ChargeParameterDiscoveryResponse& in, struct iso20_dc_DC_C
     std::visit(ModeResponseVisitor(out), in.transfer_mode);
 }
 
-template <> int serialize_to_exi(const DC_ChargeParameterDiscoveryResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <>
+int serialize_to_exi(const DC_ChargeParameterDiscoveryResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_ChargeParameterDiscoveryRes);
@@ -152,8 +154,9 @@ template <> void insert_type(VariantAccess& va, const struct iso20_dc_DC_ChargeP
     va.insert_type<DC_ChargeParameterDiscoveryResponse>(in);
 };
 
-template <> size_t serialize(const DC_ChargeParameterDiscoveryResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const DC_ChargeParameterDiscoveryResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing a DCChargeParameterResponse (EVSEside)
 
@@ -204,16 +207,18 @@ template <> void insert_type(VariantAccess& va, const struct iso20_dc_DC_ChargeP
     va.insert_type<DC_ChargeParameterDiscoveryRequest>(in);
 }
 
-template <> int serialize_to_exi(const DC_ChargeParameterDiscoveryRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <>
+int serialize_to_exi(const DC_ChargeParameterDiscoveryRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
     CB_SET_USED(doc.DC_ChargeParameterDiscoveryReq);
     convert(in, doc.DC_ChargeParameterDiscoveryReq);
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_ChargeParameterDiscoveryRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const DC_ChargeParameterDiscoveryRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing a DCChargeParameterRequest (EVside)
 
@@ -2,8 +2,10 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <iso15118/message/dc_pre_charge.hpp>
 
+#include <algorithm>
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -19,6 +21,64 @@ template <> void convert(const struct iso20_dc_DC_PreChargeReqType& in, DC_PreCh
     convert(in.EVTargetVoltage, out.target_voltage);
 }
 
+DC_PreChargeRequestView::DC_PreChargeRequestView(const DC_PreChargeRequest& message_) : message(&message_) {
+}
+
+DC_PreChargeRequestView::DC_PreChargeRequestView(const struct iso20_dc_DC_PreChargeReqType& document_) :
+    document(&document_) {
+}
+
+Header DC_PreChargeRequestView::get_header() const {
+    if (message) {
+        return message->header;
+    }
+
+    Header header;
+    convert(document->Header, header);
+    return header;
+}
+
+datatypes::SessionId DC_PreChargeRequestView::get_session_id() const {
+    if (message) {
+        return message->header.session_id;
+    }
+
+    datatypes::SessionId session_id{};
+    std::copy(document->Header.SessionID.bytes, document->Header.SessionID.bytes + document->Header.SessionID.bytesLen,
+              session_id.begin());
+    return session_id;
+}
+
+datatypes::Processing DC_PreChargeRequestView::get_processing() const {
+    if (message) {
+        return message->processing;
+    }
+
+    datatypes::Processing processing;
+    cb_convert_enum(document->EVProcessing, processing);
+    return processing;
+}
+
+datatypes::RationalNumber DC_PreChargeRequestView::get_present_voltage() const {
+    if (message) {
+        return message->present_voltage;
+    }
+
+    datatypes::RationalNumber present_voltage;
+    convert(document->EVPresentVoltage, present_voltage);
+    return present_voltage;
+}
+
+datatypes::RationalNumber DC_PreChargeRequestView::get_target_voltage() const {
+    if (message) {
+        return message->target_voltage;
+    }
+
+    datatypes::RationalNumber target_voltage;
+    convert(document->EVTargetVoltage, target_voltage);
+    return target_voltage;
+}
+
 template <> void convert(const struct iso20_dc_DC_PreChargeResType& in, DC_PreChargeResponse& out) {
 
     cb_convert_enum(in.ResponseCode, out.response_code);
@@ -38,8 +98,8 @@ template <> void convert(const DC_PreChargeResponse& in, struct iso20_dc_DC_PreC
     convert(in.present_voltage, out.EVSEPresentVoltage);
 }
 
-template <> int serialize_to_exi(const DC_PreChargeResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_PreChargeResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_PreChargeRes);
@@ -49,8 +109,8 @@ template <> int serialize_to_exi(const DC_PreChargeResponse& in, exi_bitstream_t
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_PreChargeResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const DC_PreChargeResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 template <> void insert_type(VariantAccess& va, const struct iso20_dc_DC_PreChargeReqType& in) {
@@ -66,8 +126,8 @@ template <> void convert(const DC_PreChargeRequest& in, iso20_dc_DC_PreChargeReq
     convert(in.header, out.Header);
 }
 
-template <> int serialize_to_exi(const DC_PreChargeRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_PreChargeRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_PreChargeReq);
@@ -77,8 +137,8 @@ template <> int serialize_to_exi(const DC_PreChargeRequest& in, exi_bitstream_t&
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_PreChargeRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const DC_PreChargeRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -41,8 +42,8 @@ template <> void convert(const DC_WeldingDetectionResponse& in, struct iso20_dc_
     convert(in.present_voltage, out.EVSEPresentVoltage);
 }
 
-template <> int serialize_to_exi(const DC_WeldingDetectionResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_WeldingDetectionResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_WeldingDetectionRes);
@@ -52,8 +53,9 @@ template <> int serialize_to_exi(const DC_WeldingDetectionResponse& in, exi_bits
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_WeldingDetectionResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const DC_WeldingDetectionResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 template <> void convert(const DC_WeldingDetectionRequest& in, iso20_dc_DC_WeldingDetectionReqType& out) {
@@ -64,8 +66,8 @@ template <> void convert(const DC_WeldingDetectionRequest& in, iso20_dc_DC_Weldi
     convert(in.header, out.Header);
 }
 
-template <> int serialize_to_exi(const DC_WeldingDetectionRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+template <> int serialize_to_exi(const DC_WeldingDetectionRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_WeldingDetectionReq);
@@ -75,8 +77,9 @@ template <> int serialize_to_exi(const DC_WeldingDetectionRequest& in, exi_bitst
     return encode_iso20_dc_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const DC_WeldingDetectionRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const DC_WeldingDetectionRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
\ No newline at end of file
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <iso15118/message/peek_type.hpp>
+
+#include <array>
+#include <cstddef>
+
+#include <iso15118/message/registry.hpp>
+
+namespace iso15118::message_20 {
+
+// EXI header without cookie and options, version 1
+static constexpr uint8_t EXI_HEADER = 0x80;
+
+// The event code of the document root directly follows the header. For the iso20 schemas it has 6 bits and indexes
+// the global elements in alphabetical order, the appHand schema only needs 2 bits.
+static constexpr auto ISO20_EVENT_CODE_BITS = 6;
+static constexpr auto APP_HAND_EVENT_CODE_BITS = 2;
+
+using EventCodeTable = std::array<Type, 1 << ISO20_EVENT_CODE_BITS>;
+
+struct EventCodeEntry {
+    io::v2gtp::PayloadType payload_type;
+    uint8_t event_code;
+    Type type;
+};
+
+#define CREATE_EVENT_CODE_ENTRIES(name, payload_type, document, field, event_code)                                     \
+    {io::v2gtp::PayloadType::payload_type, event_code, Type::name##Req},                                               \
+        {io::v2gtp::PayloadType::payload_type, event_code + 1, Type::name##Res},
+
+static constexpr EventCodeEntry EVENT_CODE_ENTRIES[] = {FOR_EACH_MESSAGE_20(CREATE_EVENT_CODE_ENTRIES)};
+
+#undef CREATE_EVENT_CODE_ENTRIES
+
+static constexpr EventCodeTable create_table(io::v2gtp::PayloadType payload_type) {
+    EventCodeTable table{};
+    for (const auto& entry : EVENT_CODE_ENTRIES) {
+        if (entry.payload_type == payload_type) {
+            table[entry.event_code] = entry.type;
+        }
+    }
+    return table;
+}
+
+// NOTE: unknown event codes map to Type::None, because it is the first enumerator
+static constexpr auto SAP_TABLE = create_table(io::v2gtp::PayloadType::SAP);
+static constexpr auto MAIN_TABLE = create_table(io::v2gtp::PayloadType::Part20Main);
+static constexpr auto DC_TABLE = create_table(io::v2gtp::PayloadType::Part20DC);
+static constexpr auto AC_TABLE = create_table(io::v2gtp::PayloadType::Part20AC);
+
+Type peek_type(io::v2gtp::PayloadType payload_type, const io::StreamInputView& payload) {
+    if (payload.payload_len < 2 or payload.payload[0] != EXI_HEADER) {
+        return Type::None;
+    }
+
+    const auto first_byte = payload.payload[1];
+
+    switch (payload_type) {
+    case io::v2gtp::PayloadType::SAP:
+        return SAP_TABLE[first_byte >> (8 - APP_HAND_EVENT_CODE_BITS)];
+    case io::v2gtp::PayloadType::Part20Main:
+        return MAIN_TABLE[first_byte >> (8 - ISO20_EVENT_CODE_BITS)];
+    case io::v2gtp::PayloadType::Part20DC:
+        return DC_TABLE[first_byte >> (8 - ISO20_EVENT_CODE_BITS)];
+    case io::v2gtp::PayloadType::Part20AC:
+        return AC_TABLE[first_byte >> (8 - ISO20_EVENT_CODE_BITS)];
+    }
+
+    return Type::None;
+}
+
+} // namespace iso15118::message_20
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -122,8 +123,8 @@ template <> void insert_type(VariantAccess& va, const struct iso20_PowerDelivery
     va.insert_type<PowerDeliveryResponse>(in);
 };
 
-template <> int serialize_to_exi(const PowerDeliveryResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const PowerDeliveryResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.PowerDeliveryRes);
@@ -133,8 +134,8 @@ template <> int serialize_to_exi(const PowerDeliveryResponse& in, exi_bitstream_
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const PowerDeliveryResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const PowerDeliveryResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing a PowerDeliveryResponse (EVSEside)
 
@@ -158,8 +159,8 @@ template <> void insert_type(VariantAccess& va, const struct iso20_PowerDelivery
     va.insert_type<PowerDeliveryRequest>(in);
 };
 
-template <> int serialize_to_exi(const PowerDeliveryRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const PowerDeliveryRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.PowerDeliveryReq);
@@ -169,8 +170,8 @@ template <> int serialize_to_exi(const PowerDeliveryRequest& in, exi_bitstream_t
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const PowerDeliveryRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const PowerDeliveryRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing a PowerDeliveryRequest (EVside)
 
@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include <iso15118/detail/cb_exi.hpp>
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Decoder.h>
@@ -551,8 +552,8 @@ template <> void insert_type(VariantAccess& va, const struct iso20_ScheduleExcha
     va.insert_type<ScheduleExchangeRequest>(in);
 };
 
-template <> int serialize_to_exi(const ScheduleExchangeResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const ScheduleExchangeResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ScheduleExchangeRes);
@@ -562,8 +563,8 @@ template <> int serialize_to_exi(const ScheduleExchangeResponse& in, exi_bitstre
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const ScheduleExchangeResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const ScheduleExchangeResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing a ScheduleExchangeResponse (EVSESide)
 
@@ -668,8 +669,8 @@ template <> void convert(const ScheduleExchangeRequest& in, iso20_ScheduleExchan
     convert(in.header, out.Header);
 }
 
-template <> int serialize_to_exi(const ScheduleExchangeRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const ScheduleExchangeRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ScheduleExchangeReq);
@@ -679,8 +680,8 @@ template <> int serialize_to_exi(const ScheduleExchangeRequest& in, exi_bitstrea
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const ScheduleExchangeRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const ScheduleExchangeRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 // End conversion for serializing a ScheduleExchangeRequest (EVCCSide)
 
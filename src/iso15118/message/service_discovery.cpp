@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -102,8 +103,8 @@ template <> void insert_type(VariantAccess& va, const struct iso20_ServiceDiscov
     va.insert_type<ServiceDiscoveryResponse>(in);
 };
 
-template <> int serialize_to_exi(const ServiceDiscoveryResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const ServiceDiscoveryResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ServiceDiscoveryRes);
@@ -113,8 +114,8 @@ template <> int serialize_to_exi(const ServiceDiscoveryResponse& in, exi_bitstre
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> int serialize_to_exi(const ServiceDiscoveryRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const ServiceDiscoveryRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ServiceDiscoveryReq);
@@ -124,12 +125,12 @@ template <> int serialize_to_exi(const ServiceDiscoveryRequest& in, exi_bitstrea
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const ServiceDiscoveryResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const ServiceDiscoveryResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
-template <> size_t serialize(const ServiceDiscoveryRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const ServiceDiscoveryRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -74,8 +75,8 @@ template <> void insert_type(VariantAccess& va, const struct iso20_ServiceSelect
     va.insert_type<ServiceSelectionResponse>(in);
 };
 
-template <> int serialize_to_exi(const ServiceSelectionResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const ServiceSelectionResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ServiceSelectionRes);
@@ -85,8 +86,8 @@ template <> int serialize_to_exi(const ServiceSelectionResponse& in, exi_bitstre
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> int serialize_to_exi(const ServiceSelectionRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const ServiceSelectionRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ServiceSelectionReq);
@@ -96,12 +97,12 @@ template <> int serialize_to_exi(const ServiceSelectionRequest& in, exi_bitstrea
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const ServiceSelectionResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const ServiceSelectionResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
-template <> size_t serialize(const ServiceSelectionRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const ServiceSelectionRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -53,8 +54,8 @@ template <> void convert(const SessionStopResponse& in, struct iso20_SessionStop
     cb_convert_enum(in.response_code, out.ResponseCode);
 }
 
-template <> int serialize_to_exi(const SessionStopResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const SessionStopResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.SessionStopRes);
@@ -64,8 +65,8 @@ template <> int serialize_to_exi(const SessionStopResponse& in, exi_bitstream_t&
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> int serialize_to_exi(const SessionStopRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+template <> int serialize_to_exi(const SessionStopRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().main;
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.SessionStopReq);
@@ -75,12 +76,12 @@ template <> int serialize_to_exi(const SessionStopRequest& in, exi_bitstream_t&
     return encode_iso20_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const SessionStopResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const SessionStopResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
-template <> size_t serialize(const SessionStopRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <> size_t serialize(const SessionStopRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include <iso15118/detail/cb_exi.hpp>
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/app_handshake/appHand_Encoder.h>
@@ -57,12 +58,24 @@ template <> void convert(const SupportedAppProtocolResponse& in, struct appHand_
     }
 }
 
+template <> void convert(const struct appHand_supportedAppProtocolRes& in, SupportedAppProtocolResponse& out) {
+    cb_convert_enum(in.ResponseCode, out.response_code);
+
+    if (in.SchemaID_isUsed) {
+        out.schema_id = in.SchemaID;
+    }
+}
+
 template <> void insert_type(VariantAccess& va, const struct appHand_supportedAppProtocolReq& in) {
     va.insert_type<SupportedAppProtocolRequest>(in);
 };
 
-template <> int serialize_to_exi(const SupportedAppProtocolResponse& in, exi_bitstream_t& out) {
-    appHand_exiDocument doc;
+template <> void insert_type(VariantAccess& va, const struct appHand_supportedAppProtocolRes& in) {
+    va.insert_type<SupportedAppProtocolResponse>(in);
+};
+
+template <> int serialize_to_exi(const SupportedAppProtocolResponse& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().app_hand;
     init_appHand_exiDocument(&doc);
 
     convert(in, doc.supportedAppProtocolRes);
@@ -72,8 +85,8 @@ template <> int serialize_to_exi(const SupportedAppProtocolResponse& in, exi_bit
     return encode_appHand_exiDocument(&out, &doc);
 }
 
-template <> int serialize_to_exi(const SupportedAppProtocolRequest& in, exi_bitstream_t& out) {
-    appHand_exiDocument doc;
+template <> int serialize_to_exi(const SupportedAppProtocolRequest& in, exi_bitstream_t& out, CodecContext& codec) {
+    auto& doc = codec.get_documents().app_hand;
     init_appHand_exiDocument(&doc);
 
     convert(in, doc.supportedAppProtocolReq);
@@ -83,12 +96,14 @@ template <> int serialize_to_exi(const SupportedAppProtocolRequest& in, exi_bits
     return encode_appHand_exiDocument(&out, &doc);
 }
 
-template <> size_t serialize(const SupportedAppProtocolResponse& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const SupportedAppProtocolResponse& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
-template <> size_t serialize(const SupportedAppProtocolRequest& in, const io::StreamOutputView& out) {
-    return serialize_helper(in, out);
+template <>
+size_t serialize(const SupportedAppProtocolRequest& in, const io::StreamOutputView& out, CodecContext& codec) {
+    return serialize_helper(in, out, codec);
 }
 
 } // namespace iso15118::message_20
@@ -2,11 +2,18 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <iso15118/message/variant.hpp>
 
+#include <array>
 #include <cassert>
 #include <string>
 
+#include <iso15118/detail/codec_context.hpp>
 #include <iso15118/detail/helper.hpp>
 #include <iso15118/detail/variant_access.hpp>
+#include <iso15118/message/ac_charge_loop.hpp>
+#include <iso15118/message/dc_charge_loop.hpp>
+#include <iso15118/message/dc_pre_charge.hpp>
+#include <iso15118/message/peek_type.hpp>
+#include <iso15118/message/registry.hpp>
 
 #include <cbv2g/app_handshake/appHand_Decoder.h>
 #include <cbv2g/iso_20/iso20_AC_Decoder.h>
@@ -17,148 +24,136 @@ using PayloadType = iso15118::io::v2gtp::PayloadType;
 
 namespace iso15118::message_20 {
 
-static void handle_sap(VariantAccess& va) {
-    appHand_exiDocument doc;
-
-    const auto decode_status = decode_appHand_exiDocument(&va.input_stream, &doc);
+// NOTE: the messages of the charge loop must not allocate
+static_assert(Variant::stores_inplace<DC_ChargeLoopRequest>, "DC_ChargeLoopRequest exceeds the in place storage");
+static_assert(Variant::stores_inplace<DC_ChargeLoopResponse>, "DC_ChargeLoopResponse exceeds the in place storage");
+static_assert(Variant::stores_inplace<AC_ChargeLoopRequest>, "AC_ChargeLoopRequest exceeds the in place storage");
+static_assert(Variant::stores_inplace<AC_ChargeLoopResponse>, "AC_ChargeLoopResponse exceeds the in place storage");
+static_assert(Variant::stores_inplace<DC_PreChargeRequest>, "DC_PreChargeRequest exceeds the in place storage");
+static_assert(Variant::stores_inplace<DC_PreChargeResponse>, "DC_PreChargeResponse exceeds the in place storage");
+
+static bool decode_document(PayloadType payload_type, VariantAccess& va, CodecContext::Documents& docs) {
+    int decode_status;
+    const char* decoder;
+
+    switch (payload_type) {
+    case PayloadType::SAP:
+        decode_status = decode_appHand_exiDocument(&va.input_stream, &docs.app_hand);
+        decoder = "decode_appHand_exiDocument";
+        break;
+    case PayloadType::Part20Main:
+        decode_status = decode_iso20_exiDocument(&va.input_stream, &docs.main);
+        decoder = "decode_iso20_exiDocument";
+        break;
+    case PayloadType::Part20DC:
+        decode_status = decode_iso20_dc_exiDocument(&va.input_stream, &docs.dc);
+        decoder = "decode_iso20_dc_exiDocument";
+        break;
+    case PayloadType::Part20AC:
+        decode_status = decode_iso20_ac_exiDocument(&va.input_stream, &docs.ac);
+        decoder = "decode_iso20_ac_exiDocument";
+        break;
+    default:
+        logf_warning("Unknown type");
+        return false;
+    }
 
     if (decode_status != 0) {
-        va.error = "decode_appHand_exiDocument failed with " + std::to_string(decode_status);
-        return;
+        va.error = std::string(decoder) + " failed with " + std::to_string(decode_status);
+        return false;
     }
 
-    if (doc.supportedAppProtocolReq_isUsed) {
-        insert_type(va, doc.supportedAppProtocolReq);
+    return true;
+}
+
+template <typename CbExiMessageType>
+static void insert_if_used(VariantAccess& va, bool is_used, const CbExiMessageType& message) {
+    if (is_used) {
+        insert_type(va, message);
     } else {
         va.error = "chosen message type unhandled";
     }
 }
 
-static void handle_main(VariantAccess& va) {
-    iso20_exiDocument doc;
+using InsertFunction = void (*)(VariantAccess&, const CodecContext::Documents&);
 
-    const auto decode_status = decode_iso20_exiDocument(&va.input_stream, &doc);
+#define ADD_INSERT_FUNCTIONS(name, payload_type, document, field, event_code)                                          \
+    table[to_index(Type::name##Req)] = [](VariantAccess& va, const CodecContext::Documents& docs) {                    \
+        insert_if_used(va, docs.document.field##Req_isUsed, docs.document.field##Req);                                 \
+    };                                                                                                                 \
+    table[to_index(Type::name##Res)] = [](VariantAccess& va, const CodecContext::Documents& docs) {                    \
+        insert_if_used(va, docs.document.field##Res_isUsed, docs.document.field##Res);                                 \
+    };
 
-    if (decode_status != 0) {
-        va.error = "decode_iso20_exiDocument failed with " + std::to_string(decode_status);
-        return;
-    }
+static constexpr std::array<InsertFunction, TYPE_COUNT> create_insert_functions() {
+    std::array<InsertFunction, TYPE_COUNT> table{};
 
-    if (doc.SessionSetupReq_isUsed) {
-        insert_type(va, doc.SessionSetupReq);
-    } else if (doc.SessionSetupRes_isUsed) {
-        insert_type(va, doc.SessionSetupRes);
-    } else if (doc.AuthorizationSetupReq_isUsed) {
-        insert_type(va, doc.AuthorizationSetupReq);
-    } else if (doc.AuthorizationSetupRes_isUsed) {
-        insert_type(va, doc.AuthorizationSetupRes);
-    } else if (doc.AuthorizationReq_isUsed) {
-        insert_type(va, doc.AuthorizationReq);
-    } else if (doc.AuthorizationRes_isUsed) {
-        insert_type(va, doc.AuthorizationRes);
-    } else if (doc.ServiceDiscoveryReq_isUsed) {
-        insert_type(va, doc.ServiceDiscoveryReq);
-    } else if (doc.ServiceDiscoveryRes_isUsed) {
-        insert_type(va, doc.ServiceDiscoveryRes);
-    } else if (doc.ServiceDetailReq_isUsed) {
-        insert_type(va, doc.ServiceDetailReq);
-    } else if (doc.ServiceDetailRes_isUsed) {
-        insert_type(va, doc.ServiceDetailRes);
-    } else if (doc.ServiceSelectionReq_isUsed) {
-        insert_type(va, doc.ServiceSelectionReq);
-    } else if (doc.ServiceSelectionRes_isUsed) {
-        insert_type(va, doc.ServiceSelectionRes);
-    } else if (doc.ScheduleExchangeReq_isUsed) {
-        insert_type(va, doc.ScheduleExchangeReq);
-    } else if (doc.ScheduleExchangeRes_isUsed) {
-        insert_type(va, doc.ScheduleExchangeRes);
-    } else if (doc.PowerDeliveryReq_isUsed) {
-        insert_type(va, doc.PowerDeliveryReq);
-    } else if (doc.PowerDeliveryRes_isUsed) {
-        insert_type(va, doc.PowerDeliveryRes);
-    } else if (doc.SessionStopReq_isUsed) {
-        insert_type(va, doc.SessionStopReq);
-    } else if (doc.SessionStopRes_isUsed) {
-        insert_type(va, doc.SessionStopRes);
-    } else {
+    // Type::None, the event code is not known
+    table[to_index(Type::None)] = [](VariantAccess& va, const CodecContext::Documents&) {
         va.error = "chosen message type unhandled";
-    }
+    };
+
+    FOR_EACH_MESSAGE_20(ADD_INSERT_FUNCTIONS)
+
+    return table;
 }
 
-static void handle_dc(VariantAccess& va) {
-    iso20_dc_exiDocument doc;
+#undef ADD_INSERT_FUNCTIONS
 
-    const auto decode_status = decode_iso20_dc_exiDocument(&va.input_stream, &doc);
+// indexed by the message type, which is peeked from the event code of the decoded document root
+static constexpr auto INSERT_FUNCTIONS = create_insert_functions();
 
-    if (decode_status != 0) {
-        va.error = "decode_iso20_dc_exiDocument failed with " + std::to_string(decode_status);
-        return;
-    }
+namespace {
 
-    if (doc.DC_ChargeParameterDiscoveryReq_isUsed) {
-        insert_type(va, doc.DC_ChargeParameterDiscoveryReq);
-    } else if (doc.DC_ChargeParameterDiscoveryRes_isUsed) {
-        insert_type(va, doc.DC_ChargeParameterDiscoveryRes);
-    } else if (doc.DC_CableCheckReq_isUsed) {
-        insert_type(va, doc.DC_CableCheckReq);
-    } else if (doc.DC_CableCheckRes_isUsed) {
-        insert_type(va, doc.DC_CableCheckRes);
-    } else if (doc.DC_PreChargeReq_isUsed) {
-        insert_type(va, doc.DC_PreChargeReq);
-    } else if (doc.DC_PreChargeRes_isUsed) {
-        insert_type(va, doc.DC_PreChargeRes);
-    } else if (doc.DC_ChargeLoopReq_isUsed) {
-        insert_type(va, doc.DC_ChargeLoopReq);
-    } else if (doc.DC_ChargeLoopRes_isUsed) {
-        insert_type(va, doc.DC_ChargeLoopRes);
-    } else if (doc.DC_WeldingDetectionReq_isUsed) {
-        insert_type(va, doc.DC_WeldingDetectionReq);
-    } else if (doc.DC_WeldingDetectionRes_isUsed) {
-        insert_type(va, doc.DC_WeldingDetectionRes);
-    } else {
-        va.error = "chosen message type unhandled";
+template <typename ViewType> std::optional<ViewType> decode_view(exi_bitstream_t&, CodecContext&);
+
+template <> std::optional<DC_ChargeLoopRequestView> decode_view(exi_bitstream_t& stream, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
+
+    if (decode_iso20_dc_exiDocument(&stream, &doc) != 0 or not doc.DC_ChargeLoopReq_isUsed) {
+        return std::nullopt;
     }
-}
 
-static void handle_ac(VariantAccess& va) {
-    iso20_ac_exiDocument doc;
+    return DC_ChargeLoopRequestView(doc.DC_ChargeLoopReq);
+}
 
-    const auto decode_status = decode_iso20_ac_exiDocument(&va.input_stream, &doc);
+template <> std::optional<DC_PreChargeRequestView> decode_view(exi_bitstream_t& stream, CodecContext& codec) {
+    auto& doc = codec.get_documents().dc;
 
-    if (decode_status != 0) {
-        va.error = "decode_iso20_dc_exiDocument failed with " + std::to_string(decode_status);
-        return;
+    if (decode_iso20_dc_exiDocument(&stream, &doc) != 0 or not doc.DC_PreChargeReq_isUsed) {
+        return std::nullopt;
     }
 
-    if (doc.AC_ChargeParameterDiscoveryReq_isUsed) {
-        insert_type(va, doc.AC_ChargeParameterDiscoveryReq);
-    } else if (doc.AC_ChargeParameterDiscoveryRes_isUsed) {
-        insert_type(va, doc.AC_ChargeParameterDiscoveryRes);
-    } else if (doc.AC_ChargeLoopReq_isUsed) {
-        insert_type(va, doc.AC_ChargeLoopReq);
-    } else if (doc.AC_ChargeLoopRes_isUsed) {
-        insert_type(va, doc.AC_ChargeLoopRes);
-    } else {
-        va.error = "chosen message type unhandled";
+    return DC_PreChargeRequestView(doc.DC_PreChargeReq);
+}
+
+template <> std::optional<AC_ChargeLoopRequestView> decode_view(exi_bitstream_t& stream, CodecContext& codec) {
+    auto& doc = codec.get_documents().ac;
+
+    if (decode_iso20_ac_exiDocument(&stream, &doc) != 0 or not doc.AC_ChargeLoopReq_isUsed) {
+        return std::nullopt;
     }
+
+    return AC_ChargeLoopRequestView(doc.AC_ChargeLoopReq);
 }
 
+} // namespace
+
 Variant::Variant(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view) {
+    CodecContext codec;
+    decode(payload_type, buffer_view, codec);
+}
 
-    VariantAccess va{
-        get_exi_input_stream(buffer_view), this->data, this->type, this->custom_deleter, this->error,
-    };
+void Variant::decode(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view, CodecContext& codec) {
+    reset();
+    // NOTE: clearing keeps the capacity, so a reused variant does not allocate here
+    error.clear();
 
-    if (payload_type == PayloadType::SAP) {
-        handle_sap(va);
-    } else if (payload_type == PayloadType::Part20Main) {
-        handle_main(va);
-    } else if (payload_type == PayloadType::Part20DC) {
-        handle_dc(va);
-    } else if (payload_type == PayloadType::Part20AC) {
-        handle_ac(va);
-    } else {
-        logf_warning("Unknown type");
+    VariantAccess va{get_exi_input_stream(buffer_view), *this, this->error};
+
+    auto& docs = codec.get_documents();
+    if (decode_document(payload_type, va, docs)) {
+        INSERT_FUNCTIONS[to_index(peek_type(payload_type, buffer_view))](va, docs);
     }
 
     if (data) {
@@ -170,10 +165,77 @@ Variant::Variant(io::v2gtp::PayloadType payload_type, const io::StreamInputView&
     }
 }
 
+void Variant::defer_decode(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view,
+                           CodecContext& codec) {
+    reset();
+    error.clear();
+
+    const auto peeked_type = peek_type(payload_type, buffer_view);
+    if (peeked_type == Type::None) {
+        // nothing to defer, the full decode tells what's wrong
+        decode(payload_type, buffer_view, codec);
+        return;
+    }
+
+    type = peeked_type;
+    pending_decode = PendingDecode{payload_type, buffer_view, &codec};
+}
+
+void Variant::discard_pending_decode() {
+    pending_decode.reset();
+}
+
+void Variant::decode_pending() {
+    const auto pending = *pending_decode;
+    decode(pending.payload_type, pending.payload, *pending.codec);
+}
+
+template <typename ViewType> std::optional<ViewType> Variant::get_view() const {
+    using MessageType = typename ViewType::Message;
+
+    if (TypeTrait<MessageType>::type != type) {
+        return std::nullopt;
+    }
+
+    if (pending_decode) {
+        auto stream = get_exi_input_stream(pending_decode->payload);
+        if (auto view = decode_view<ViewType>(stream, *pending_decode->codec)) {
+            // NOTE: decoding the payload again would overwrite the document the view refers to
+            const_cast<Variant*>(this)->pending_decode.reset();
+            return view;
+        }
+
+        // the full decode tells what's wrong
+        const_cast<Variant*>(this)->decode_pending();
+        if (TypeTrait<MessageType>::type != type) {
+            return std::nullopt;
+        }
+    }
+
+    if (data == nullptr) {
+        return std::nullopt;
+    }
+
+    return ViewType(*static_cast<const MessageType*>(data));
+}
+
+template std::optional<DC_ChargeLoopRequestView> Variant::get_view() const;
+template std::optional<DC_PreChargeRequestView> Variant::get_view() const;
+template std::optional<AC_ChargeLoopRequestView> Variant::get_view() const;
+
 Variant::~Variant() {
+    reset();
+}
+
+void Variant::reset() {
     if (data) {
         custom_deleter(data);
     }
+
+    data = nullptr;
+    custom_deleter = nullptr;
+    type = Type::None;
+    pending_decode.reset();
 }
 
 Type Variant::get_type() const {
@@ -2,10 +2,9 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #include <iso15118/session/iso.hpp>
 
+#include <algorithm>
 #include <cassert>
-#include <chrono>
 #include <cstring>
-#include <thread>
 
 #include <endian.h>
 
@@ -16,38 +15,36 @@
 namespace iso15118 {
 
 static constexpr auto SESSION_IDLE_TIMEOUT_MS = 5000;
+// Wait for the EV to close the connection for 5 seconds [V2G20-1643]
+static constexpr auto SESSION_LINGER_TIMEOUT_MS = 5000;
 
-static void log_sdp_packet(const iso15118::io::SdpPacket& sdp) {
+static void log_v2gtp_frame(const iso15118::io::V2gtpFrame& frame) {
     static constexpr auto ESCAPED_BYTE_CHAR_COUNT = 4;
-    auto payload_string_buffer = std::make_unique<char[]>(sdp.get_payload_length() * ESCAPED_BYTE_CHAR_COUNT + 1);
-    for (std::size_t i = 0; i < sdp.get_payload_length(); ++i) {
+    const auto& payload = frame.payload;
+    auto payload_string_buffer = std::make_unique<char[]>(payload.payload_len * ESCAPED_BYTE_CHAR_COUNT + 1);
+    for (std::size_t i = 0; i < payload.payload_len; ++i) {
         snprintf(payload_string_buffer.get() + i * ESCAPED_BYTE_CHAR_COUNT, ESCAPED_BYTE_CHAR_COUNT + 1, "\\x%02hx",
-                 sdp.get_payload_buffer()[i]);
+                 payload.payload[i]);
     }
 
-    iso15118::logf_info("[SDP Packet in]: Header: %04hx, Payload: %s", sdp.get_payload_type(),
+    iso15118::logf_info("[SDP Packet in]: Header: %04hx, Payload: %s", frame.payload_type,
                         payload_string_buffer.get());
 }
 
-static void log_packet_from_car(const iso15118::io::SdpPacket& packet, session::SessionLogger& logger) {
-    logger.exi(static_cast<uint16_t>(packet.get_payload_type()), packet.get_payload_buffer(),
-               packet.get_payload_length(), session::logging::ExiMessageDirection::FROM_EV);
+static void log_frame_from_car(const iso15118::io::V2gtpFrame& frame, session::SessionLogger& logger) {
+    logger.exi(static_cast<uint16_t>(frame.payload_type), frame.payload.payload, frame.payload.payload_len,
+               session::logging::ExiMessageDirection::FROM_EV);
 }
 
-static std::unique_ptr<message_20::Variant> make_variant_from_packet(const iso15118::io::SdpPacket& packet) {
-    return std::make_unique<message_20::Variant>(
-        packet.get_payload_type(), io::StreamInputView{packet.get_payload_buffer(), packet.get_payload_length()});
-}
-
-void raise_invalid_packet_state(const io::SdpPacket& sdp_packet) {
-    using PacketState = io::SdpPacket::State;
+void raise_invalid_reader_state(const io::V2gtpReader& reader) {
+    using ReaderState = io::V2gtpReader::State;
 
     auto error = std::string("Error while reading sdp packet: ");
-    switch (sdp_packet.get_state()) {
-    case PacketState::INVALID_HEADER:
+    switch (reader.get_state()) {
+    case ReaderState::INVALID_HEADER:
         error += "invalid sdp packet header";
         break;
-    case PacketState::PAYLOAD_TO_LONG:
+    case ReaderState::PAYLOAD_TO_LONG:
         error += "packet too large for buffer";
         break;
     default:
@@ -57,54 +54,6 @@ void raise_invalid_packet_state(const io::SdpPacket& sdp_packet) {
     log_and_throw(error.c_str());
 }
 
-// NOTE (aw): this function return true, if it would block to read a complete packet
-//            if it returns false, the packet is complete
-bool read_single_sdp_packet(io::IConnection& connection, io::SdpPacket& sdp_packet) {
-    // NOTE (aw): not happy with this function
-    //            main problem is, that it combines too much logic of the sdp packet and io related stuff
-    using PacketState = io::SdpPacket::State;
-
-    assert(sdp_packet.get_state() == PacketState::EMPTY || sdp_packet.get_state() == PacketState::HEADER_READ);
-
-    const auto first_try =
-        connection.read(sdp_packet.get_current_buffer_pos(), sdp_packet.get_remaining_bytes_to_read());
-
-    sdp_packet.update_read_bytes(first_try.bytes_read);
-
-    if (first_try.would_block) {
-        // need more data for at least the header
-        return true;
-    }
-
-    if (sdp_packet.get_state() == PacketState::COMPLETE) {
-        // done
-        return false;
-    }
-
-    // packet not finished
-    if (sdp_packet.get_state() != PacketState::HEADER_READ) {
-        raise_invalid_packet_state(sdp_packet);
-    }
-
-    // header read successfully, try to read the rest
-    const auto second_try =
-        connection.read(sdp_packet.get_current_buffer_pos(), sdp_packet.get_remaining_bytes_to_read());
-
-    sdp_packet.update_read_bytes(second_try.bytes_read);
-
-    if (second_try.would_block) {
-        // need more data for the rest of the packet!
-        return true;
-    }
-
-    // assert finished packet
-    if (sdp_packet.get_state() != PacketState::COMPLETE) {
-        raise_invalid_packet_state(sdp_packet);
-    }
-
-    return false;
-}
-
 static size_t setup_response_header(uint8_t* buffer, iso15118::io::v2gtp::PayloadType payload_type, size_t size) {
     buffer[0] = iso15118::io::SDP_PROTOCOL_VERSION;
     buffer[1] = iso15118::io::SDP_INVERSE_PROTOCOL_VERSION;
@@ -132,24 +81,42 @@ Session::Session(std::unique_ptr<io::IConnection> connection_, d20::SessionConfi
     connection->set_event_callback([this](io::ConnectionEvent event) { this->handle_connection_event(event); });
 }
 
-Session::~Session() = default;
+Session::~Session() {
+    const auto& stats = message_exchange.get_encoded_size_stats();
+
+    for (std::size_t i = 0; i < message_20::TYPE_COUNT; ++i) {
+        const auto type = static_cast<message_20::Type>(i);
+        const auto& entry = stats.get(type);
+        if (entry.count == 0) {
+            continue;
+        }
+
+        const auto fallbacks = entry.count - entry.size_class_counts.front();
+        logf_debug("Encoded %s: %u times, %zu bytes on average, %zu bytes max, %u times exceeding %zu bytes",
+                   message_20::to_string(type), entry.count, entry.total_size / entry.count, entry.max_size, fallbacks,
+                   d20::OutputBufferPool::SIZE_CLASSES.front());
+    }
+}
 
 void Session::push_control_event(const d20::ControlEvent& event) {
-    control_event_queue.push(event);
+    if (not control_event_queue.push(event)) {
+        logf_warning("Control event queue is full, discarded a state event (%zu discarded so far)",
+                     control_event_queue.get_dropped_count());
+    }
 }
 
 TimePoint const& Session::poll() {
     const auto now = get_current_time_point();
 
-    if (not state.connected) {
-        // nothing happened so far, just return
+    if (not state.connected or state.closing) {
+        // nothing happened so far or the connection is torn down, just return
         next_session_event = offset_time_point_by_ms(now, SESSION_IDLE_TIMEOUT_MS);
         return next_session_event;
     }
 
-    // check for new data to read
+    // check for new data to read, a single read drains as much as available
     if (state.new_data) {
-        const bool would_block = read_single_sdp_packet(*connection, packet);
+        const bool would_block = reader.fill(*connection);
 
         if (would_block) {
             state.new_data = false;
@@ -157,30 +124,7 @@ TimePoint const& Session::poll() {
     }
 
     // send all of our queued control events
-    while ((active_control_event = control_event_queue.pop()) != std::nullopt) {
-
-        if (const auto control_data = ctx.get_control_event<d20::DcTransferLimits>()) {
-            ctx.session_config.dc_limits = *control_data;
-        } else if (const auto control_data = ctx.get_control_event<d20::EnergyServices>()) {
-            ctx.session_config.supported_energy_transfer_services = *control_data;
-        } else if (const auto control_data = ctx.get_control_event<d20::SupportedVASs>()) {
-            ctx.session_config.supported_vas_services = *control_data;
-        } else if (const auto control_data = ctx.get_control_event<d20::AcTransferLimits>()) {
-            ctx.session_config.ac_limits = *control_data;
-        } else if (const auto control_data = ctx.get_control_event<d20::UpdateDynamicModeParameters>()) {
-            ctx.cache_dynamic_mode_parameters.emplace(*control_data);
-        } else if (const auto control_data = ctx.get_control_event<d20::AcTargetPower>()) {
-            ctx.cache_ac_target_power.emplace(*control_data);
-        } else if (const auto control_data = ctx.get_control_event<d20::AcPresentPower>()) {
-            ctx.cache_ac_present_power.emplace(*control_data);
-        }
-        // Save some control events. It can happen that these events are sent before the corresponding state. They are
-        // stored temporarily here.
-        // TODO(sl): Construct ControlEventCache Struct
-
-        [[maybe_unused]] const auto res = fsm.feed(d20::Event::CONTROL_MESSAGE);
-        // FIXME (aw): check result!
-    }
+    handle_control_events();
 
     const auto timeouts_reached = timeouts.check();
 
@@ -201,58 +145,148 @@ TimePoint const& Session::poll() {
         }
     }
 
-    // check for complete sdp packet
-    if (packet.is_complete()) {
-        // FIXME (aw): this event loop only acts on new packets, seems to be enough for now ...
-        log_packet_from_car(packet, log);
+    // handle all complete frames, they are parsed in place from the receive buffer
+    while (not(ctx.session_stopped or ctx.session_paused)) {
+        const auto frame = reader.next_frame();
+        if (not frame) {
+            break;
+        }
 
-        message_exchange.set_request(make_variant_from_packet(packet));
+        handle_frame(*frame);
+        send_pending_response();
+    }
 
-        packet = {}; // reset the packet
+    if (reader.get_state() != io::V2gtpReader::State::OK) {
+        raise_invalid_reader_state(reader);
+    }
 
-        const auto request_msg_type = ctx.peek_request_type();
+    send_pending_response();
 
-        // There is no sequence timer before SupportedAppProtocol
-        if (request_msg_type != message_20::Type::SupportedAppProtocolReq) {
-            timeouts.stop_timeout(d20::TimeoutType::SEQUENCE);
-        }
+    if (ctx.session_stopped or ctx.session_paused) {
+        // TODO(SL): Does this also apply when a timeout is triggered? Or should the TCP/TLS connection be terminated
+        // directly?
+        state.closing = true;
+        connection->linger_and_close(SESSION_LINGER_TIMEOUT_MS);
+        // NOTE: the dlink signal is sent, once the connection is closed
+    }
 
-        ctx.feedback.v2g_message(request_msg_type);
+    if (state.new_data) {
+        // there might be more data buffered in the connection, so poll again right away
+        next_session_event = now;
+    } else if (const auto next_deadline = timeouts.get_next_deadline()) {
+        next_session_event = std::min(next_deadline.value(), offset_time_point_by_ms(now, SESSION_IDLE_TIMEOUT_MS));
+    } else {
+        next_session_event = offset_time_point_by_ms(now, SESSION_IDLE_TIMEOUT_MS);
+    }
 
-        [[maybe_unused]] const auto res = fsm.feed(d20::Event::V2GTP_MESSAGE);
-        // FIXME(sl): check result!
+    return next_session_event;
+}
+
+void Session::handle_frame(const io::V2gtpFrame& frame) {
+    log_frame_from_car(frame, log);
+
+    message_exchange.set_request(frame.payload_type, frame.payload);
+
+    const auto request_msg_type = ctx.peek_request_type();
+
+    // There is no sequence timer before SupportedAppProtocol
+    if (request_msg_type != message_20::Type::SupportedAppProtocolReq) {
+        timeouts.stop_timeout(d20::TimeoutType::SEQUENCE);
     }
 
+    ctx.feedback.v2g_message(request_msg_type);
+
+    [[maybe_unused]] const auto res = fsm.feed(d20::Event::V2GTP_MESSAGE);
+    // FIXME(sl): check result!
+
+    // the reader reuses the buffer of the frame for the next ones
+    message_exchange.release_request_payload();
+}
+
+void Session::send_pending_response() {
     const auto [got_response, payload_size, payload_type, response_type] = message_exchange.check_and_clear_response();
 
-    if (got_response) {
-        const auto response_size = setup_response_header(response_buffer, payload_type, payload_size);
-        connection->write(response_buffer, response_size);
+    if (not got_response) {
+        return;
+    }
+
+    // the header is reserved in front of the payload of every output buffer
+    const auto& payload = message_exchange.get_response_view();
+    const auto response_buffer = payload.payload - io::SdpPacket::V2GTP_HEADER_SIZE;
+
+    const auto response_size = setup_response_header(response_buffer, payload_type, payload_size);
+    connection->write(response_buffer, response_size);
 
-        timeouts.start_timeout(d20::TimeoutType::SEQUENCE, d20::TIMEOUT_SEQUENCE);
+    timeouts.start_timeout(d20::TimeoutType::SEQUENCE, d20::TIMEOUT_SEQUENCE);
 
-        // FIXME (aw): this is hacky ...
-        log.exi(static_cast<uint16_t>(payload_type), response_buffer + io::SdpPacket::V2GTP_HEADER_SIZE, payload_size,
-                session::logging::ExiMessageDirection::TO_EV);
+    // FIXME (aw): this is hacky ...
+    log.exi(static_cast<uint16_t>(payload_type), payload.payload, payload_size,
+            session::logging::ExiMessageDirection::TO_EV);
+
+    ctx.feedback.v2g_message(response_type);
+}
 
-        ctx.feedback.v2g_message(response_type);
+void Session::handle_control_events() {
+    if (not ctx.session_config.coalesce_control_events) {
+        while ((active_control_event = control_event_queue.pop()) != std::nullopt) {
+            handle_active_control_event();
+        }
+        return;
     }
 
-    if (ctx.session_stopped or ctx.session_paused) {
-        // TODO(SL): Does this also apply when a timeout is triggered? Or should the TCP/TLS connection be terminated
-        // directly?
-        // Wait for 5 seconds [V2G20-1643]
-        std::this_thread::sleep_for(std::chrono::seconds(5));
-        connection->close();
+    const auto flush_coalesced_events = [this]() {
+        for (auto& event : coalesced_control_events) {
+            if (event) {
+                active_control_event = std::move(event);
+                event.reset();
+                handle_active_control_event();
+            }
+        }
+    };
 
-        const auto signal =
-            (ctx.session_paused) ? session::feedback::Signal::DLINK_PAUSE : session::feedback::Signal::DLINK_TERMINATE;
-        ctx.feedback.signal(signal);
+    while (auto event = control_event_queue.pop()) {
+        if (d20::is_state_control_event(*event)) {
+            // only the newest value per type is of interest
+            coalesced_control_events[event->index()] = std::move(event);
+            continue;
+        }
+
+        // edge events stay in order, the state they were sent with is handled before
+        flush_coalesced_events();
+
+        active_control_event = std::move(event);
+        handle_active_control_event();
     }
 
-    // FIXME (aw): proper timeout handling!
-    next_session_event = offset_time_point_by_ms(now, SESSION_IDLE_TIMEOUT_MS);
-    return next_session_event;
+    flush_coalesced_events();
+    active_control_event.reset();
+}
+
+void Session::handle_active_control_event() {
+    if (const auto control_data = ctx.get_control_event<d20::DcTransferLimits>()) {
+        ctx.session_config.dc_limits = *control_data;
+    } else if (const auto control_data = ctx.get_control_event<d20::EnergyServices>()) {
+        ctx.session_config.supported_energy_transfer_services = *control_data;
+        // the shared templates belong to the previous config
+        ctx.session_config.response_templates.reset();
+    } else if (const auto control_data = ctx.get_control_event<d20::SupportedVASs>()) {
+        ctx.session_config.supported_vas_services = *control_data;
+        ctx.session_config.response_templates.reset();
+    } else if (const auto control_data = ctx.get_control_event<d20::AcTransferLimits>()) {
+        ctx.session_config.ac_limits = *control_data;
+    } else if (const auto control_data = ctx.get_control_event<d20::UpdateDynamicModeParameters>()) {
+        ctx.cache_dynamic_mode_parameters.emplace(*control_data);
+    } else if (const auto control_data = ctx.get_control_event<d20::AcTargetPower>()) {
+        ctx.cache_ac_target_power.emplace(*control_data);
+    } else if (const auto control_data = ctx.get_control_event<d20::AcPresentPower>()) {
+        ctx.cache_ac_present_power.emplace(*control_data);
+    }
+    // Save some control events. It can happen that these events are sent before the corresponding state. They are
+    // stored temporarily here.
+    // TODO(sl): Construct ControlEventCache Struct
+
+    [[maybe_unused]] const auto res = fsm.feed(d20::Event::CONTROL_MESSAGE);
+    // FIXME (aw): check result!
 }
 
 void Session::handle_connection_event(io::ConnectionEvent event) {
@@ -278,17 +312,24 @@ void Session::handle_connection_event(io::ConnectionEvent event) {
         // NOTE (aw): for now, we don't really need this information ...
         return;
 
-    case Event::CLOSED:
+    case Event::CLOSED: {
         state.connected = false;
+        state.closed = true;
         logf_info("Connection is closed");
+
+        const auto signal =
+            (ctx.session_paused) ? session::feedback::Signal::DLINK_PAUSE : session::feedback::Signal::DLINK_TERMINATE;
+        ctx.feedback.signal(signal);
         return;
     }
+    }
 }
 
 void Session::close() {
-    connection->close();
-    ctx.feedback.signal(session::feedback::Signal::DLINK_TERMINATE);
     ctx.session_stopped = true;
+    ctx.session_paused = false;
+    state.closing = true;
+    connection->close();
 }
 
 } // namespace iso15118
@@ -3,11 +3,13 @@
 #include <iso15118/tbd_controller.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 
 #include <iso15118/io/connection_plain.hpp>
 #include <iso15118/io/connection_ssl.hpp>
+#include <iso15118/io/event_loop.hpp>
 #include <iso15118/session/iso.hpp>
 
 #include <iso15118/detail/helper.hpp>
@@ -15,11 +17,56 @@
 
 namespace iso15118 {
 
+struct TbdController::Shard : io::EventLoop {
+    using io::EventLoop::EventLoop;
+
+    // number of sessions, used for the load balancing
+    std::atomic<size_t> load{0};
+
+    // only accessed by the thread of this shard
+    std::vector<Connector*> sessions;
+    std::optional<io::TimerId> wakeup_timer{std::nullopt};
+};
+
 TbdController::TbdController(TbdConfig config_, session::feedback::Callbacks callbacks_, d20::EvseSetupConfig setup_) :
-    config(std::move(config_)),
-    callbacks(std::move(callbacks_)),
-    evse_setup(std::move(setup_)),
-    interface_name(config.interface_name) {
+    TbdController(config_, {{config_.interface_name, std::move(setup_), std::move(callbacks_)}}) {
+}
+
+TbdController::TbdController(TbdConfig config_, std::vector<TbdConnectorConfig> connector_configs) :
+    config(std::move(config_)) {
+
+    if (connector_configs.empty()) {
+        throw std::runtime_error("At least one connector needs to be configured!");
+    }
+
+    if (config.worker_threads == 0) {
+        shards.push_back(std::make_unique<Shard>(poll_manager));
+    } else {
+        for (size_t i = 0; i < config.worker_threads; ++i) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    for (auto& connector_config : connector_configs) {
+        add_connector(std::move(connector_config));
+    }
+
+    if (config.tls_negotiation_strategy != config::TlsNegotiationStrategy::ENFORCE_NO_TLS) {
+        // NOTE: loading the certificates takes a while, so it is done once here and not after the sdp request
+        ssl_server_context = std::make_unique<io::SSLServerContext>(config.ssl);
+
+        if (const auto watch_fd = ssl_server_context->start_watching(); watch_fd != -1) {
+            poll_manager.register_fd(watch_fd, [this]() { ssl_server_context->handle_file_events(); });
+        }
+    }
+}
+
+TbdController::~TbdController() {
+    stop_shards();
+}
+
+void TbdController::add_connector(TbdConnectorConfig connector_config) {
+    auto interface_name = connector_config.interface_name;
 
     const auto result_interface_check = io::check_and_update_interface(interface_name);
     if (result_interface_check) {
@@ -28,68 +75,216 @@ TbdController::TbdController(TbdConfig config_, session::feedback::Callbacks cal
         throw std::runtime_error("Ethernet interface was not found!");
     }
 
+    const auto same_interface = std::find_if(connectors.begin(), connectors.end(), [&interface_name](const auto& it) {
+        return it.second.interface_name == interface_name;
+    });
+
+    if (same_interface != connectors.end()) {
+        const auto error_msg =
+            std::string("Ethernet interface ") + interface_name + " is already used by another connector!";
+        throw std::runtime_error(error_msg);
+    }
+
+    const auto added_connector = connectors.add(connector_config.interface_name);
+    if (added_connector == nullptr) {
+        throw std::runtime_error("Connector " + connector_config.interface_name + " is configured twice!");
+    }
+
+    auto& connector = *added_connector;
+    connector.interface_name = std::move(interface_name);
+    connector.callbacks = std::move(connector_config.callbacks);
+    connector.evse_setup = std::move(connector_config.evse_setup);
+
     if (config.enable_sdp_server) {
-        sdp_server = std::make_unique<io::SdpServer>(interface_name);
-        poll_manager.register_fd(sdp_server->get_fd(), [this]() { handle_sdp_server_input(); });
+        connector.sdp_server = std::make_unique<io::SdpServer>(connector.interface_name);
+        poll_manager.register_fd(connector.sdp_server->get_fd(),
+                                 [this, &connector]() { handle_sdp_server_input(connector); });
     }
 }
 
+d20::SessionConfig TbdController::create_session_config(const Connector& connector) {
+    d20::SessionConfig session_config(connector.evse_setup);
+    session_config.response_templates = connector.response_templates;
+    return session_config;
+}
+
+TbdController::Shard* TbdController::get_least_loaded_shard() {
+    Shard* least_loaded_shard = nullptr;
+
+    for (const auto& shard : shards) {
+        if (shard->has_failed()) {
+            continue;
+        }
+
+        if (least_loaded_shard == nullptr or shard->load < least_loaded_shard->load) {
+            least_loaded_shard = shard.get();
+        }
+    }
+
+    return least_loaded_shard;
+}
+
+std::unique_ptr<io::IConnection> TbdController::create_connection(io::PollManager& shard_poll_manager,
+                                                                  const Connector& connector, bool secure_connection) {
+    try {
+        if (secure_connection) {
+            if (not ssl_server_context) {
+                throw std::runtime_error("TLS is disabled");
+            }
+            return std::make_unique<io::ConnectionSSL>(shard_poll_manager, connector.interface_name,
+                                                       *ssl_server_context);
+        }
+        return std::make_unique<io::ConnectionPlain>(shard_poll_manager, connector.interface_name);
+    } catch (const std::runtime_error& e) {
+        logf_error("%s", e.what());
+        return nullptr;
+    }
+}
+
+void TbdController::assign_plain_session(Connector& connector) {
+    const auto least_loaded_shard = get_least_loaded_shard();
+    if (least_loaded_shard == nullptr) {
+        throw std::runtime_error("No shard is left to run the session on " + connector.interface_name);
+    }
+
+    auto& shard = *least_loaded_shard;
+    {
+        std::scoped_lock lock(connector.mutex);
+        connector.shard = &shard;
+    }
+    shard.load++;
+
+    // NOTE: the session stays within this shard, it gets restarted there once finished
+    shard.post([this, &shard, &connector]() {
+        start_plain_session(shard, connector);
+        shard.sessions.push_back(&connector);
+    });
+}
+
+void TbdController::start_plain_session(Shard& shard, Connector& connector) {
+    auto connection = std::make_unique<io::ConnectionPlain>(shard.get_poll_manager(), connector.interface_name);
+
+    std::scoped_lock lock(connector.mutex);
+    connector.session = std::make_unique<Session>(std::move(connection), create_session_config(connector),
+                                                  connector.callbacks, connector.pause_ctx);
+}
+
 void TbdController::loop() {
-    static constexpr auto POLL_MANAGER_TIMEOUT_MS = 50;
+    for (auto& shard : shards) {
+        if (&shard->get_poll_manager() != &poll_manager) {
+            shard->start([this, &shard = *shard]() { prepare_shard_wakeup(shard); });
+        }
+    }
 
     if (not config.enable_sdp_server) {
-        auto connection = std::make_unique<io::ConnectionPlain>(poll_manager, interface_name);
-        session =
-            std::make_unique<Session>(std::move(connection), d20::SessionConfig(evse_setup), callbacks, pause_ctx);
+        for (auto& [name, connector] : connectors) {
+            assign_plain_session(connector);
+        }
     }
 
-    auto next_event = get_current_time_point();
+    if (config.worker_threads == 0) {
+        // the only shard shares the poll manager with the sdp servers
+        auto& shard = *shards.front();
+        shard.run([this, &shard]() { prepare_shard_wakeup(shard); });
+        return;
+    }
 
+    // sdp front-end, new sessions are handed over to the shards
     while (true) {
-        const auto poll_timeout_ms = get_timeout_ms_until(next_event, POLL_MANAGER_TIMEOUT_MS);
-
         try {
-            poll_manager.poll(poll_timeout_ms);
+            poll_manager.poll(-1);
         } catch (const std::runtime_error& e) {
             logf_error("Shutdown loop() because of: %s", e.what());
             break;
         }
+    }
 
-        next_event = offset_time_point_by_ms(get_current_time_point(), POLL_MANAGER_TIMEOUT_MS);
+    stop_shards();
+}
 
-        if (session) {
-            try {
-                const auto next_session_event = session->poll();
-                next_event = std::min(next_event, next_session_event);
-            } catch (const std::runtime_error& e) {
-                logf_error("Shutting down session because of: %s", e.what());
-                logf_info("Restarting session ...");
-                session->close();
-            }
+void TbdController::stop_shards() {
+    for (auto& shard : shards) {
+        shard->stop();
+    }
+}
 
-            if (session->is_finished()) {
-                session.reset();
+void TbdController::prepare_shard_wakeup(Shard& shard) {
+    const auto next_event = poll_sessions(shard);
 
-                if (not config.enable_sdp_server) {
-                    auto connection = std::make_unique<io::ConnectionPlain>(poll_manager, interface_name);
-                    session = std::make_unique<Session>(std::move(connection), d20::SessionConfig(evse_setup),
-                                                        callbacks, pause_ctx);
-                }
-            }
+    // sleep until the next session deadline or until some io event happens
+    if (shard.wakeup_timer) {
+        shard.get_poll_manager().cancel_timer(*shard.wakeup_timer);
+        shard.wakeup_timer.reset();
+    }
+
+    if (next_event != TimePoint::max()) {
+        shard.wakeup_timer = shard.get_poll_manager().schedule_timer(next_event, []() {});
+    }
+}
+
+TimePoint TbdController::poll_sessions(Shard& shard) {
+    auto next_event = TimePoint::max();
+
+    for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+        auto& connector = **it;
+
+        try {
+            const auto next_session_event = connector.session->poll();
+            next_event = std::min(next_event, next_session_event);
+        } catch (const std::runtime_error& e) {
+            logf_error("Shutting down session on %s because of: %s", connector.interface_name.c_str(), e.what());
+            logf_info("Restarting session ...");
+            connector.session->close();
+        }
+
+        if (not connector.session->is_finished()) {
+            ++it;
+            continue;
+        }
+
+        if (not config.enable_sdp_server) {
+            start_plain_session(shard, connector);
+            // poll the new session right away
+            next_event = get_current_time_point();
+            ++it;
+            continue;
         }
+
+        {
+            std::scoped_lock lock(connector.mutex);
+            connector.session.reset();
+            connector.shard = nullptr;
+        }
+        shard.load--;
+        it = shard.sessions.erase(it);
     }
+
+    return next_event;
 }
 
 void TbdController::send_control_event(const d20::ControlEvent& event) {
-    if (session) {
-        session->push_control_event(event);
-    }
+    send_control_event(connectors.get_default_name(), event);
+}
+
+void TbdController::send_control_event(const std::string& connector_name, const d20::ControlEvent& event) {
+    connectors.push_control_event(connector_name, event);
 }
 
 void TbdController::update_authorization_services(const std::vector<message_20::datatypes::Authorization>& services,
                                                   bool cert_install_service) {
+    update_authorization_services(connectors.get_default_name(), services, cert_install_service);
+}
+
+void TbdController::update_authorization_services(const std::string& connector_name,
+                                                  const std::vector<message_20::datatypes::Authorization>& services,
+                                                  bool cert_install_service) {
+    auto& connector = connectors.get(connector_name);
+
+    std::scoped_lock lock(connector.mutex);
+    auto& evse_setup = connector.evse_setup;
 
     evse_setup.enable_certificate_install_service = cert_install_service;
+    connector.response_templates = std::make_shared<d20::ResponseTemplateCache>();
 
     if (services.empty()) {
         logf_warning("The authorization services are not updated because services are empty!");
@@ -99,50 +294,104 @@ void TbdController::update_authorization_services(const std::vector<message_20::
 }
 
 void TbdController::update_dc_limits(const d20::DcTransferLimits& limits) {
+    update_dc_limits(connectors.get_default_name(), limits);
+}
 
-    evse_setup.dc_limits = limits;
+void TbdController::update_dc_limits(const std::string& connector_name, const d20::DcTransferLimits& limits) {
+    auto& connector = connectors.get(connector_name);
 
-    if (session) {
-        session->push_control_event(limits);
-    }
+    std::scoped_lock lock(connector.mutex);
+    connector.evse_setup.dc_limits = limits;
+
+    connectors.push_control_event(connector, limits);
 }
 
 void TbdController::update_powersupply_limits(const d20::DcTransferLimits& limits) {
-    evse_setup.powersupply_limits = limits;
+    update_powersupply_limits(connectors.get_default_name(), limits);
+}
+
+void TbdController::update_powersupply_limits(const std::string& connector_name, const d20::DcTransferLimits& limits) {
+    auto& connector = connectors.get(connector_name);
+
+    std::scoped_lock lock(connector.mutex);
+    connector.evse_setup.powersupply_limits = limits;
 }
 
 void TbdController::update_energy_modes(const std::vector<message_20::datatypes::ServiceCategory>& modes) {
-    evse_setup.supported_energy_services = modes;
+    update_energy_modes(connectors.get_default_name(), modes);
+}
 
-    if (session) {
-        session->push_control_event(modes);
-    }
+void TbdController::update_energy_modes(const std::string& connector_name,
+                                        const std::vector<message_20::datatypes::ServiceCategory>& modes) {
+    auto& connector = connectors.get(connector_name);
+
+    std::scoped_lock lock(connector.mutex);
+    connector.evse_setup.supported_energy_services = modes;
+    connector.response_templates = std::make_shared<d20::ResponseTemplateCache>();
+
+    connectors.push_control_event(connector, modes);
 }
 
 void TbdController::update_supported_vas_services(const d20::SupportedVASs& vas_services) {
+    update_supported_vas_services(connectors.get_default_name(), vas_services);
+}
 
-    evse_setup.supported_vas_services = vas_services;
+void TbdController::update_supported_vas_services(const std::string& connector_name,
+                                                  const d20::SupportedVASs& vas_services) {
+    auto& connector = connectors.get(connector_name);
 
-    if (session) {
-        session->push_control_event(vas_services);
-    }
+    std::scoped_lock lock(connector.mutex);
+    connector.evse_setup.supported_vas_services = vas_services;
+    connector.response_templates = std::make_shared<d20::ResponseTemplateCache>();
+
+    connectors.push_control_event(connector, vas_services);
 }
 
 void TbdController::update_ac_limits(const d20::AcTransferLimits& limits) {
+    update_ac_limits(connectors.get_default_name(), limits);
+}
+
+void TbdController::update_ac_limits(const std::string& connector_name, const d20::AcTransferLimits& limits) {
+    auto& connector = connectors.get(connector_name);
 
-    evse_setup.ac_limits = limits;
+    std::scoped_lock lock(connector.mutex);
+    connector.evse_setup.ac_limits = limits;
+
+    connectors.push_control_event(connector, limits);
+}
 
-    if (session) {
-        session->push_control_event(limits);
+bool TbdController::reload_certificates() {
+    if (not ssl_server_context) {
+        return false;
     }
+
+    return ssl_server_context->reload();
 }
 
-void TbdController::handle_sdp_server_input() {
-    auto request = sdp_server->get_peer_request();
+io::TlsHandshakeStats TbdController::get_tls_handshake_stats() const {
+    if (not ssl_server_context) {
+        return {};
+    }
 
-    if (session) {
-        logf_warning("Ignoring sdp request message because a session is already created and running");
-        return;
+    return ssl_server_context->get_handshake_stats();
+}
+
+void TbdController::handle_sdp_server_input(Connector& connector) {
+    auto request = connector.sdp_server->get_peer_request();
+
+    {
+        std::scoped_lock lock(connector.mutex);
+        if (connector.shard and connector.shard->has_failed()) {
+            // the session went down together with its shard, nothing touches it anymore
+            logf_warning("Dropping the session on %s, because its shard failed", connector.interface_name.c_str());
+            connector.session.reset();
+            connector.shard = nullptr;
+        }
+
+        if (connector.shard) {
+            logf_warning("Ignoring sdp request message because a session is already created and running");
+            return;
+        }
     }
 
     if (not request) {
@@ -161,28 +410,47 @@ void TbdController::handle_sdp_server_input() {
         break;
     }
 
-    auto connection = [this](bool secure_connection) -> std::unique_ptr<io::IConnection> {
-        try {
-            if (secure_connection) {
-                return std::make_unique<io::ConnectionSSL>(poll_manager, interface_name, config.ssl);
-            }
-            return std::make_unique<io::ConnectionPlain>(poll_manager, interface_name);
-        } catch (const std::runtime_error& e) {
-            logf_error("%s", e.what());
-            return nullptr;
-        }
-    }(request.security == io::v2gtp::Security::TLS);
+    const auto least_loaded_shard = get_least_loaded_shard();
+    if (least_loaded_shard == nullptr) {
+        // stops the sdp front-end as well, there is nothing left to run the sessions
+        throw std::runtime_error("All shards failed");
+    }
 
-    if (not connection) {
-        logf_error("A TCP/TLS connection could not be established. Ignoring this SDP request for now");
-        return;
+    auto& shard = *least_loaded_shard;
+    {
+        std::scoped_lock lock(connector.mutex);
+        connector.shard = &shard;
     }
+    shard.load++;
+
+    const auto secure_connection = (request.security == io::v2gtp::Security::TLS);
+
+    // the connection and the session need to be created within the thread of the shard. NOTE: the sdp front-end
+    // doesn't wait for it, so a busy shard doesn't delay the sdp requests of the other connectors
+    shard.post([this, &shard, &connector, secure_connection, request]() {
+        auto connection = create_connection(shard.get_poll_manager(), connector, secure_connection);
+        if (not connection) {
+            logf_error("A TCP/TLS connection could not be established. Ignoring this SDP request for now");
+            {
+                std::scoped_lock lock(connector.mutex);
+                connector.shard = nullptr;
+            }
+            shard.load--;
+            return;
+        }
 
-    const auto ipv6_endpoint = connection->get_public_endpoint();
+        const auto ipv6_endpoint = connection->get_public_endpoint();
 
-    session = std::make_unique<Session>(std::move(connection), d20::SessionConfig(evse_setup), callbacks, pause_ctx);
+        {
+            std::scoped_lock lock(connector.mutex);
+            connector.session = std::make_unique<Session>(std::move(connection), create_session_config(connector),
+                                                          connector.callbacks, connector.pause_ctx);
+        }
+        shard.sessions.push_back(&connector);
 
-    sdp_server->send_response(request, ipv6_endpoint);
+        // NOTE: only uses the socket of the sdp server, so it is fine to send from this thread
+        connector.sdp_server->send_response(request, ipv6_endpoint);
+    });
 }
 
 } // namespace iso15118
@@ -37,7 +37,23 @@ SCENARIO("App Protocol Ser/Des") {
         }
     }
 
-    // Todo(sl): Missing Decode message
-    // 80400040
-    // {"supportedAppProtocolRes": {"ResponseCode": "OK_SuccessfulNegotiation", "SchemaID": 1}}
+    GIVEN("A binary representation of an AppProtocolRes document") {
+
+        // {"supportedAppProtocolRes": {"ResponseCode": "OK_SuccessfulNegotiation", "SchemaID": 1}}
+        uint8_t doc_raw[] = {0x80, 0x40, 0x00, 0x40};
+
+        const io::StreamInputView stream_view{doc_raw, sizeof(doc_raw)};
+
+        message_20::Variant variant(io::v2gtp::PayloadType::SAP, stream_view);
+
+        THEN("It should be decoded succussfully") {
+            REQUIRE(variant.get_type() == message_20::Type::SupportedAppProtocolRes);
+
+            const auto& msg = variant.get<message_20::SupportedAppProtocolResponse>();
+
+            REQUIRE(msg.response_code ==
+                    message_20::SupportedAppProtocolResponse::ResponseCode::OK_SuccessfulNegotiation);
+            REQUIRE(msg.schema_id == 1);
+        }
+    }
 }
@@ -0,0 +1,242 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <vector>
+
+#include <iso15118/detail/codec_context.hpp>
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/dc_charge_loop.hpp>
+#include <iso15118/message/session_setup.hpp>
+#include <iso15118/message/variant.hpp>
+
+#include <iso15118/detail/cb_exi.hpp>
+
+#include <cbv2g/iso_20/iso20_CommonMessages_Decoder.h>
+#include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
+#include <cbv2g/iso_20/iso20_DC_Decoder.h>
+#include <cbv2g/iso_20/iso20_DC_Encoder.h>
+
+#include "helper.hpp"
+
+using namespace iso15118;
+
+namespace {
+
+uint8_t session_setup_req_raw[] = {0x80, 0x8c, 0x4,  0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0xc,  0x9f,
+                                   0x9c, 0x2b, 0xd0, 0x62, 0xb,  0x2b, 0xa6, 0xa4, 0xab, 0x18, 0x99, 0x19, 0x9a,
+                                   0x1a, 0x9b, 0x1b, 0x9c, 0x1c, 0x98, 0x20, 0xa1, 0x21, 0xa2, 0x22, 0xac, 0x0};
+
+uint8_t dc_charge_loop_req_raw[] = {0x80, 0x34, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c,
+                                    0x4d, 0x8c, 0xdb, 0xfe, 0x1b, 0x60, 0x62, 0x81, 0x00, 0x12,
+                                    0x00, 0x64, 0x64, 0x00, 0x0a, 0x02, 0x00, 0x24, 0x00, 0xca};
+
+message_20::SessionSetupResponse create_session_setup_res() {
+    const auto header = message_20::Header{{0x2E, 0xFA, 0x18, 0x94, 0xDC, 0x7B, 0x90, 0x11}, 1739635913};
+    return {header, message_20::datatypes::ResponseCode::OK_NewSessionEstablished, "DE*PNX*E12345*1"};
+}
+
+message_20::DC_ChargeLoopRequest create_dc_charge_loop_req() {
+    message_20::DC_ChargeLoopRequest req;
+    req.header = message_20::Header{{0x3D, 0x4C, 0xBF, 0x93, 0x37, 0x4E, 0xD8, 0x9B}, 1725456333};
+    req.meter_info_requested = false;
+    auto& control_mode = req.control_mode.emplace<message_20::datatypes::Scheduled_DC_CLReqControlMode>();
+    control_mode.target_current = {20, 0};
+    control_mode.target_voltage = {400, 0};
+    req.present_voltage = {400, 0};
+    return req;
+}
+
+// Stack usage is measured by painting a stack area below the caller with a pattern, running the function at the same
+// stack depth and checking how much of the pattern got overwritten.
+constexpr size_t STACK_PROBE_SIZE = 1024 * 1024;
+constexpr uint8_t STACK_PATTERN = 0xA5;
+
+[[gnu::noinline]] void paint_stack() {
+    volatile uint8_t area[STACK_PROBE_SIZE];
+    for (size_t i = 0; i < STACK_PROBE_SIZE; ++i) {
+        area[i] = STACK_PATTERN;
+    }
+}
+
+[[gnu::noinline]] size_t get_painted_stack_usage() {
+    volatile uint8_t area[STACK_PROBE_SIZE];
+    size_t untouched = 0;
+    while (untouched < STACK_PROBE_SIZE and area[untouched] == STACK_PATTERN) {
+        untouched++;
+    }
+    return STACK_PROBE_SIZE - untouched;
+}
+
+template <typename Function> [[gnu::noinline]] size_t measure_stack_usage(const Function& function) {
+    paint_stack();
+    function();
+    return get_painted_stack_usage();
+}
+
+// the document on the stack is how every message was de- and encoded before the codec context
+template <typename Document, typename Decoder>
+[[gnu::noinline]] int decode_on_stack(const io::StreamInputView& view, Decoder decoder) {
+    Document doc;
+    auto stream = get_exi_input_stream(view);
+    return decoder(&stream, &doc);
+}
+
+template <typename Document, typename Decoder>
+[[gnu::noinline]] int decode_in_context(Document& doc, const io::StreamInputView& view, Decoder decoder) {
+    auto stream = get_exi_input_stream(view);
+    return decoder(&stream, &doc);
+}
+
+template <typename Document, typename Fill, typename Encoder>
+[[gnu::noinline]] int encode_on_stack(const Fill& fill, Encoder encoder) {
+    uint8_t buffer[1024];
+    auto stream = get_exi_output_stream({buffer, sizeof(buffer)});
+    Document doc;
+    fill(doc);
+    return encoder(&stream, &doc);
+}
+
+template <typename Document, typename Fill, typename Encoder>
+[[gnu::noinline]] int encode_in_context(Document& doc, const Fill& fill, Encoder encoder) {
+    uint8_t buffer[1024];
+    auto stream = get_exi_output_stream({buffer, sizeof(buffer)});
+    fill(doc);
+    return encoder(&stream, &doc);
+}
+
+template <typename Message> size_t serialize_with(const Message& msg, message_20::CodecContext& codec) {
+    uint8_t buffer[1024];
+    const io::StreamOutputView out{buffer, sizeof(buffer)};
+    return message_20::serialize(msg, out, codec);
+}
+
+} // namespace
+
+SCENARIO("Reusing a codec context") {
+    GIVEN("A codec context") {
+        message_20::CodecContext codec;
+        message_20::Variant variant;
+
+        WHEN("Different messages are decoded one after another") {
+            variant.decode(io::v2gtp::PayloadType::Part20Main, {session_setup_req_raw, sizeof(session_setup_req_raw)},
+                           codec);
+            REQUIRE(variant.get<message_20::SessionSetupRequest>().evccid == "WMIV1234567890ABCDEX");
+
+            variant.decode(io::v2gtp::PayloadType::Part20DC, {dc_charge_loop_req_raw, sizeof(dc_charge_loop_req_raw)},
+                           codec);
+
+            THEN("The last one should be decoded correctly") {
+                const auto& msg = variant.get<message_20::DC_ChargeLoopRequest>();
+                REQUIRE(msg.header.timestamp == 1725456333);
+                REQUIRE(message_20::datatypes::from_RationalNumber(msg.present_voltage) == 400);
+            }
+        }
+
+        WHEN("Messages are encoded repeatedly") {
+            const auto res = create_session_setup_res();
+            const auto req = create_dc_charge_loop_req();
+
+            uint8_t buffer[1024];
+            const io::StreamOutputView out{buffer, sizeof(buffer)};
+
+            std::vector<uint8_t> first_encoding;
+            for (auto i = 0; i < 3; ++i) {
+                message_20::serialize(req, out, codec);
+                const auto size = message_20::serialize(res, out, codec);
+                if (i == 0) {
+                    first_encoding.assign(buffer, buffer + size);
+                }
+            }
+
+            THEN("The result should equal the one without a shared context") {
+                REQUIRE(first_encoding == serialize_helper(res));
+                REQUIRE(serialize_with(res, codec) == first_encoding.size());
+            }
+        }
+    }
+}
+
+TEST_CASE("Codec context per message type", "[.][benchmark]") {
+    message_20::CodecContext codec;
+    auto& documents = codec.get_documents();
+
+    const io::StreamInputView session_setup_req_view{session_setup_req_raw, sizeof(session_setup_req_raw)};
+    const io::StreamInputView dc_charge_loop_req_view{dc_charge_loop_req_raw, sizeof(dc_charge_loop_req_raw)};
+
+    const auto session_setup_res = create_session_setup_res();
+    const auto fill_session_setup_res = [&session_setup_res](iso20_exiDocument& doc) {
+        init_iso20_exiDocument(&doc);
+        CB_SET_USED(doc.SessionSetupRes);
+        message_20::convert(session_setup_res, doc.SessionSetupRes);
+    };
+
+    const auto dc_charge_loop_req = create_dc_charge_loop_req();
+    const auto fill_dc_charge_loop_req = [&dc_charge_loop_req](iso20_dc_exiDocument& doc) {
+        init_iso20_dc_exiDocument(&doc);
+        CB_SET_USED(doc.DC_ChargeLoopReq);
+        message_20::convert(dc_charge_loop_req, doc.DC_ChargeLoopReq);
+    };
+
+    const auto print_stack_usage = [](const char* name, size_t on_stack, size_t in_context) {
+        std::printf("stack usage %-24s: %8zu bytes with document on stack, %8zu bytes with codec context\n", name,
+                    on_stack, in_context);
+    };
+
+    print_stack_usage("decode SessionSetupReq", measure_stack_usage([&]() {
+                          decode_on_stack<iso20_exiDocument>(session_setup_req_view, decode_iso20_exiDocument);
+                      }),
+                      measure_stack_usage([&]() {
+                          decode_in_context(documents.main, session_setup_req_view, decode_iso20_exiDocument);
+                      }));
+    print_stack_usage("decode DC_ChargeLoopReq", measure_stack_usage([&]() {
+                          decode_on_stack<iso20_dc_exiDocument>(dc_charge_loop_req_view, decode_iso20_dc_exiDocument);
+                      }),
+                      measure_stack_usage([&]() {
+                          decode_in_context(documents.dc, dc_charge_loop_req_view, decode_iso20_dc_exiDocument);
+                      }));
+    print_stack_usage("encode SessionSetupRes", measure_stack_usage([&]() {
+                          encode_on_stack<iso20_exiDocument>(fill_session_setup_res, encode_iso20_exiDocument);
+                      }),
+                      measure_stack_usage([&]() {
+                          encode_in_context(documents.main, fill_session_setup_res, encode_iso20_exiDocument);
+                      }));
+    print_stack_usage("encode DC_ChargeLoopReq", measure_stack_usage([&]() {
+                          encode_on_stack<iso20_dc_exiDocument>(fill_dc_charge_loop_req, encode_iso20_dc_exiDocument);
+                      }),
+                      measure_stack_usage([&]() {
+                          encode_in_context(documents.dc, fill_dc_charge_loop_req, encode_iso20_dc_exiDocument);
+                      }));
+
+    BENCHMARK("decode SessionSetupReq with document on stack") {
+        return decode_on_stack<iso20_exiDocument>(session_setup_req_view, decode_iso20_exiDocument);
+    };
+
+    BENCHMARK("decode SessionSetupReq with codec context") {
+        return decode_in_context(documents.main, session_setup_req_view, decode_iso20_exiDocument);
+    };
+
+    BENCHMARK("decode DC_ChargeLoopReq with document on stack") {
+        return decode_on_stack<iso20_dc_exiDocument>(dc_charge_loop_req_view, decode_iso20_dc_exiDocument);
+    };
+
+    BENCHMARK("decode DC_ChargeLoopReq with codec context") {
+        return decode_in_context(documents.dc, dc_charge_loop_req_view, decode_iso20_dc_exiDocument);
+    };
+
+    BENCHMARK("encode SessionSetupRes with document on stack") {
+        return encode_on_stack<iso20_exiDocument>(fill_session_setup_res, encode_iso20_exiDocument);
+    };
+
+    BENCHMARK("encode SessionSetupRes with codec context") {
+        return encode_in_context(documents.main, fill_session_setup_res, encode_iso20_exiDocument);
+    };
+
+    BENCHMARK("encode DC_ChargeLoopReq with document on stack") {
+        return encode_on_stack<iso20_dc_exiDocument>(fill_dc_charge_loop_req, encode_iso20_dc_exiDocument);
+    };
+
+    BENCHMARK("encode DC_ChargeLoopReq with codec context") {
+        return encode_in_context(documents.dc, fill_dc_charge_loop_req, encode_iso20_dc_exiDocument);
+    };
+}
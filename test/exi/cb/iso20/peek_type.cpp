@@ -0,0 +1,268 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/peek_type.hpp>
+#include <iso15118/message/session_setup.hpp>
+#include <iso15118/message/session_stop.hpp>
+#include <iso15118/message/variant.hpp>
+
+using namespace iso15118;
+
+namespace {
+
+struct Sample {
+    io::v2gtp::PayloadType payload_type;
+    message_20::Type type;
+    std::vector<uint8_t> doc_raw;
+};
+
+// one document per message type, taken from the de/serialization tests
+const std::vector<Sample> samples = {
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::SessionSetupReq,
+     {0x80, 0x8c, 0x4, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xc, 0x9f, 0x9c,
+      0x2b, 0xd0, 0x62, 0xb, 0x2b, 0xa6, 0xa4, 0xab, 0x18, 0x99, 0x19, 0x9a, 0x1a, 0x9b,
+      0x1b, 0x9c, 0x1c, 0x98, 0x20, 0xa1, 0x21, 0xa2, 0x22, 0xac, 0x0}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::SessionSetupRes,
+     {0x80, 0x90, 0x4, 0x17, 0x7d, 0xc, 0x4a, 0x6e, 0x3d, 0xc8, 0x8, 0x8c, 0x9f, 0x9c,
+      0x2b, 0xd0, 0x62, 0x4, 0x4, 0x51, 0x11, 0x4a, 0x94, 0x13, 0x96, 0xa, 0x91, 0x4c,
+      0x4c, 0x8c, 0xcd, 0xd, 0x4a, 0x8c, 0x40}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::AuthorizationSetupReq,
+     {0x80, 0x08, 0x04, 0x79, 0x0c, 0x8a, 0xdc, 0xee, 0xee, 0x09, 0x68, 0x8d, 0x6c, 0xac,
+      0x3a, 0x60, 0x62}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::AuthorizationSetupRes,
+     {0x80, 0x0c, 0x04, 0x79, 0x0c, 0x8a, 0xdc, 0xee, 0xee, 0x09, 0x68, 0x8d, 0x6c, 0xac,
+      0x3a, 0x60, 0x62, 0x00, 0x05, 0x00}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::AuthorizationReq,
+     {0x80, 0x00, 0x04, 0x79, 0x0c, 0x8a, 0xdc, 0xee, 0xee, 0x09, 0x68, 0x8d, 0x6c, 0xac,
+      0x3a, 0x60, 0x62, 0x00}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::AuthorizationRes,
+     {0x80, 0x04, 0x04, 0x79, 0x0c, 0x8a, 0xdc, 0xee, 0xee, 0x09, 0x68, 0x8d, 0x6c, 0xac,
+      0x3a, 0x60, 0x62, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ServiceDiscoveryReq,
+     {0x80, 0x7c, 0x04, 0x02, 0x75, 0xff, 0x96, 0x4a, 0x2c, 0xed, 0xa1, 0x0e, 0x38, 0x7e,
+      0x8a, 0x60, 0x62, 0x80}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ServiceDiscoveryRes,
+     {0x80, 0x80, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x2b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x00, 0x02, 0x00, 0x01, 0x80, 0x50}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ServiceDetailReq,
+     {0x80, 0x74, 0x04, 0x02, 0x75, 0xff, 0x96, 0x4a, 0x2c, 0xed, 0xa1, 0x0e, 0x38, 0x7e,
+      0x8a, 0x60, 0x62, 0x02, 0x80}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ServiceDetailRes,
+     {0x80, 0x78, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x3b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x00, 0x80, 0x00, 0x02, 0xd0, 0xdb, 0xdb, 0x9b, 0x99, 0x58,
+      0xdd, 0x1b, 0xdc, 0x98, 0x04, 0x00, 0xd4, 0x36, 0xf6, 0xe7, 0x47, 0x26, 0xf6, 0xc4,
+      0xd6, 0xf6, 0x46, 0x56, 0x00, 0x80, 0x4d, 0x35, 0xbd, 0x89, 0xa5, 0xb1, 0xa5, 0xd1,
+      0xe5, 0x39, 0x95, 0x95, 0x91, 0xcd, 0x35, 0xbd, 0x91, 0x95, 0x80, 0x20, 0x09, 0x50,
+      0x72, 0x69, 0x63, 0x69, 0x6e, 0x67, 0x60, 0x00, 0xa0}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ServiceSelectionReq,
+     {0x80, 0x84, 0x04, 0x02, 0x75, 0xff, 0x96, 0x4a, 0x2c, 0xed, 0xa1, 0x0e, 0x38, 0x7e,
+      0x8a, 0x60, 0x62, 0x01, 0x40, 0x08, 0x80}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ServiceSelectionRes,
+     {0x80, 0x88, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x3b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ScheduleExchangeReq,
+     {0x80, 0x6c, 0x04, 0x1c, 0x90, 0x58, 0x02, 0x37, 0x25, 0x7c, 0x84, 0x8d, 0x6b, 0x0c,
+      0x4b, 0x70, 0x62, 0x7e, 0x80, 0xa0, 0x38, 0x03, 0xc1, 0x40, 0x20, 0xc0, 0xa0, 0x10,
+      0x60, 0x78, 0x08, 0x31, 0x13, 0x02, 0x0c, 0x01, 0x40, 0x80, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::ScheduleExchangeRes,
+     {0x80, 0x70, 0x04, 0x1c, 0x90, 0x58, 0x02, 0x37, 0x25, 0x7c, 0x84, 0x8d, 0x7b, 0x0c,
+      0x4b, 0x70, 0x62, 0x00, 0x02, 0x1a, 0x01, 0xe8}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::PowerDeliveryReq,
+     {0x80, 0x54, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xdb, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x00, 0x01, 0x00, 0x42, 0x00, 0xb8, 0x41, 0x00, 0x51, 0x24}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::PowerDeliveryRes,
+     {0x80, 0x58, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xdb, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x40}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::SessionStopReq,
+     {0x80, 0x94, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8d, 0x7b, 0xfe,
+      0x1b, 0x60, 0x62, 0x28}},
+    {io::v2gtp::PayloadType::Part20Main,
+     message_20::Type::SessionStopRes,
+     {0x80, 0x98, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8d, 0x7b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_ChargeParameterDiscoveryReq,
+     {0x80, 0x3c, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x3b, 0xfe,
+      0x1b, 0x60, 0x62, 0x88, 0x10, 0x98, 0x75, 0x04, 0x00, 0x32, 0x02, 0x00, 0x2b, 0x00,
+      0x81, 0x00, 0x01, 0x40, 0x80, 0x08, 0x40, 0x70, 0x40, 0x00, 0x50, 0x80}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_ChargeParameterDiscoveryRes,
+     {0x80, 0x40, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x4b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x44, 0x08, 0x50, 0x08, 0x81, 0xfc, 0x34, 0x03, 0xc0, 0xfe,
+      0x1a, 0x01, 0xe0, 0x7d, 0x0e, 0x80, 0x70, 0x3f, 0x85, 0x42, 0x30, 0x1f, 0xc3, 0x40,
+      0x3c, 0x40}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_CableCheckReq,
+     {0x80, 0x2c, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x7b, 0xfe,
+      0x1b, 0x60, 0x62}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_CableCheckRes,
+     {0x80, 0x30, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x8b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x10}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_PreChargeReq,
+     {0x80, 0x44, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xbb, 0xfe,
+      0x1b, 0x60, 0x62, 0x21, 0x00, 0x12, 0x00, 0x60, 0x80, 0x09, 0x00, 0x30}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_PreChargeRes,
+     {0x80, 0x48, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xcb, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x0f, 0xe1, 0x40, 0x3e, 0x00}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_ChargeLoopReq,
+     {0x80, 0x34, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xdb, 0xfe,
+      0x1b, 0x60, 0x62, 0x81, 0x00, 0x12, 0x00, 0x64, 0x64, 0x00, 0x0a, 0x02, 0x00, 0x24,
+      0x00, 0xca}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_ChargeLoopRes,
+     {0x80, 0x38, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xeb, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x63, 0xe8, 0x74, 0x03, 0x81, 0xfc, 0x28, 0x07, 0xc2, 0x22,
+      0x90}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_WeldingDetectionReq,
+     {0x80, 0x4c, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8d, 0x5b, 0xfe,
+      0x1b, 0x60, 0x62, 0x20}},
+    {io::v2gtp::PayloadType::Part20DC,
+     message_20::Type::DC_WeldingDetectionRes,
+     {0x80, 0x50, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8d, 0x5b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x10, 0x00, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20AC,
+     message_20::Type::AC_ChargeParameterDiscoveryReq,
+     {0x80, 0x10, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x3b, 0xfe,
+      0x1b, 0x60, 0x62, 0x07, 0xE0, 0x80, 0x19, 0x02, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00,
+      0x3F, 0x06, 0x80, 0x78, 0x10, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20AC,
+     message_20::Type::AC_ChargeParameterDiscoveryRes,
+     {0x80, 0x14, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0x4b, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x04, 0x08, 0x50, 0x08, 0x81, 0x00, 0x00, 0x00, 0x40, 0x00,
+      0x00, 0x20, 0x43, 0x40, 0x3c, 0x08, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x00,
+      0x05, 0x00}},
+    {io::v2gtp::PayloadType::Part20AC,
+     message_20::Type::AC_ChargeLoopReq,
+     {0x80, 0x08, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xdb, 0xfe,
+      0x1b, 0x60, 0x62, 0x88, 0x04, 0x00, 0x5c, 0xb0, 0x00, 0x40, 0x07, 0x02, 0xe8, 0x04,
+      0x00, 0x00, 0x80, 0x7e, 0x08, 0x01, 0x90, 0x10, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+      0x3f, 0x06, 0x80, 0x78, 0x10, 0x00, 0x00, 0x04, 0x00, 0x00, 0x02, 0x00, 0x38, 0x17,
+      0x40, 0x40, 0x00, 0x00, 0x08, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00,
+      0x10, 0x00, 0x00, 0x00}},
+    {io::v2gtp::PayloadType::Part20AC,
+     message_20::Type::AC_ChargeLoopRes,
+     {0x80, 0x0c, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xeb, 0xfe,
+      0x1b, 0x60, 0x62, 0x00, 0x10, 0x0c, 0xc4, 0x69, 0x04, 0xb1, 0x20, 0x00, 0xc8, 0x80,
+      0x40, 0x07, 0x02, 0xe8, 0x04, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x08, 0x00, 0x00,
+      0x01, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x04, 0x00, 0x70, 0x2e, 0x81, 0x00, 0x00,
+      0x00, 0x40, 0x00, 0x00, 0x00}},
+};
+
+io::StreamInputView view_of(const std::vector<uint8_t>& doc_raw) {
+    return {doc_raw.data(), doc_raw.size()};
+}
+
+} // namespace
+
+SCENARIO("Peek the message type of exi documents") {
+
+    GIVEN("A document of each message type") {
+        THEN("The peeked type should match the decoded one") {
+            for (const auto& sample : samples) {
+                CAPTURE(static_cast<int>(sample.type));
+                REQUIRE(message_20::peek_type(sample.payload_type, view_of(sample.doc_raw)) == sample.type);
+            }
+        }
+    }
+
+    GIVEN("A document with the wrong payload type") {
+        const auto& sample = samples.front();
+
+        THEN("It should not be mistaken for a message of that schema") {
+            REQUIRE(message_20::peek_type(io::v2gtp::PayloadType::Part20DC, view_of(sample.doc_raw)) !=
+                    sample.type);
+        }
+    }
+
+    GIVEN("Invalid documents") {
+        const std::vector<uint8_t> truncated = {0x80};
+        const std::vector<uint8_t> no_exi_header = {0x00, 0x8c, 0x04};
+        const std::vector<uint8_t> unknown_event_code = {0x80, 0xfc, 0x04};
+
+        THEN("No type should be peeked") {
+            REQUIRE(message_20::peek_type(io::v2gtp::PayloadType::Part20Main, view_of(truncated)) ==
+                    message_20::Type::None);
+            REQUIRE(message_20::peek_type(io::v2gtp::PayloadType::Part20Main, view_of(no_exi_header)) ==
+                    message_20::Type::None);
+            REQUIRE(message_20::peek_type(io::v2gtp::PayloadType::Part20Main, view_of(unknown_event_code)) ==
+                    message_20::Type::None);
+        }
+    }
+
+    GIVEN("A deferred decode") {
+        const auto& sample = samples.front();
+        message_20::CodecContext codec;
+        message_20::Variant variant;
+
+        variant.defer_decode(sample.payload_type, view_of(sample.doc_raw), codec);
+
+        THEN("The type should be available before decoding") {
+            REQUIRE(variant.get_type() == message_20::Type::SessionSetupReq);
+        }
+
+        THEN("Accessing another type should not decode the message") {
+            REQUIRE(variant.get_if<message_20::SessionStopRequest>() == nullptr);
+            REQUIRE(variant.get_type() == message_20::Type::SessionSetupReq);
+        }
+
+        THEN("Accessing the expected type should decode the message") {
+            const auto* msg = variant.get_if<message_20::SessionSetupRequest>();
+            REQUIRE(msg != nullptr);
+            REQUIRE(msg->evccid == "WMIV1234567890ABCDEX");
+        }
+
+        THEN("A decoded message should stay available, once the payload is released") {
+            REQUIRE(variant.get_if<message_20::SessionSetupRequest>() != nullptr);
+            variant.discard_pending_decode();
+            REQUIRE(variant.get_if<message_20::SessionSetupRequest>() != nullptr);
+        }
+    }
+}
+
+TEST_CASE("Peek vs. full decode", "[.][benchmark]") {
+    message_20::CodecContext codec;
+    message_20::Variant variant;
+
+    BENCHMARK("peek type of all messages") {
+        size_t peeked = 0;
+        for (const auto& sample : samples) {
+            peeked += (message_20::peek_type(sample.payload_type, view_of(sample.doc_raw)) == sample.type);
+        }
+        return peeked;
+    };
+
+    BENCHMARK("decode all messages") {
+        size_t decoded = 0;
+        for (const auto& sample : samples) {
+            variant.decode(sample.payload_type, view_of(sample.doc_raw), codec);
+            decoded += (variant.get_type() == sample.type);
+        }
+        return decoded;
+    };
+}
@@ -0,0 +1,206 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <iso15118/message/ac_charge_loop.hpp>
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/dc_charge_loop.hpp>
+#include <iso15118/message/dc_pre_charge.hpp>
+#include <iso15118/message/variant.hpp>
+
+#include "helper.hpp"
+
+using namespace iso15118;
+
+namespace dt = iso15118::message_20::datatypes;
+
+namespace {
+
+uint8_t dc_charge_loop_req_raw[] = {0x80, 0x34, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c,
+                                    0x4d, 0x8c, 0xdb, 0xfe, 0x1b, 0x60, 0x62, 0x81, 0x00, 0x12,
+                                    0x00, 0x64, 0x64, 0x00, 0x0a, 0x02, 0x00, 0x24, 0x00, 0xca};
+
+uint8_t ac_charge_loop_req_raw[] = {
+    0x80, 0x08, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xdb, 0xfe, 0x1b, 0x60, 0x62, 0x88, 0x04,
+    0x00, 0x5c, 0xb0, 0x00, 0x40, 0x07, 0x02, 0xe8, 0x04, 0x00, 0x00, 0x80, 0x7e, 0x08, 0x01, 0x90, 0x10, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x3f, 0x06, 0x80, 0x78, 0x10, 0x00, 0x00, 0x04, 0x00, 0x00, 0x02, 0x00, 0x38, 0x17, 0x40,
+    0x40, 0x00, 0x00, 0x08, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00};
+
+uint8_t dc_pre_charge_req_raw[] = {0x80, 0x44, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c, 0x4d, 0x8c, 0xbb,
+                                   0xfe, 0x1b, 0x60, 0x62, 0x21, 0x00, 0x12, 0x00, 0x60, 0x80, 0x09, 0x00, 0x30};
+
+const message_20::datatypes::SessionId session_id{0x3D, 0x4C, 0xBF, 0x93, 0x37, 0x4E, 0xD8, 0x9B};
+
+} // namespace
+
+SCENARIO("Request views on exi documents") {
+    message_20::CodecContext codec;
+    message_20::Variant variant;
+
+    GIVEN("A deferred dc_charge_loop_req") {
+        variant.defer_decode(io::v2gtp::PayloadType::Part20DC,
+                             {dc_charge_loop_req_raw, sizeof(dc_charge_loop_req_raw)}, codec);
+
+        THEN("Views on other messages should not be available") {
+            REQUIRE(variant.get_view<message_20::DC_PreChargeRequestView>() == std::nullopt);
+        }
+
+        THEN("The view should read the exi document") {
+            const auto view = variant.get_view<message_20::DC_ChargeLoopRequestView>();
+            REQUIRE(view.has_value());
+
+            const auto header = view->get_header();
+            REQUIRE(header.session_id == session_id);
+            REQUIRE(header.timestamp == 1725456333);
+            REQUIRE(view->get_session_id() == session_id);
+            REQUIRE(view->get_meter_info_requested() == false);
+            REQUIRE(view->get_display_parameters() == std::nullopt);
+            REQUIRE(dt::from_RationalNumber(view->get_present_voltage()) == 400);
+
+            using ScheduledMode = dt::Scheduled_DC_CLReqControlMode;
+
+            REQUIRE(view->holds_control_mode<ScheduledMode>());
+            REQUIRE(not view->holds_control_mode<dt::Dynamic_DC_CLReqControlMode>());
+
+            const auto control_mode = view->get_control_mode();
+            REQUIRE(std::holds_alternative<ScheduledMode>(control_mode));
+            REQUIRE(dt::from_RationalNumber(std::get<ScheduledMode>(control_mode).target_current) == 20);
+            REQUIRE(dt::from_RationalNumber(std::get<ScheduledMode>(control_mode).target_voltage) == 400);
+        }
+
+        THEN("The view should convert the whole request on demand") {
+            const auto view = variant.get_view<message_20::DC_ChargeLoopRequestView>();
+            REQUIRE(view.has_value());
+
+            const auto msg = view->get_message();
+            REQUIRE(msg.header.session_id == session_id);
+            REQUIRE(msg.meter_info_requested == false);
+            REQUIRE(dt::from_RationalNumber(msg.present_voltage) == 400);
+            REQUIRE(std::holds_alternative<dt::Scheduled_DC_CLReqControlMode>(msg.control_mode));
+        }
+
+        THEN("The view should consume the pending decode") {
+            REQUIRE(variant.get_view<message_20::DC_ChargeLoopRequestView>().has_value());
+
+            REQUIRE(variant.get_type() == message_20::Type::DC_ChargeLoopReq);
+            REQUIRE(variant.get_view<message_20::DC_ChargeLoopRequestView>() == std::nullopt);
+            REQUIRE(variant.get_if<message_20::DC_ChargeLoopRequest>() == nullptr);
+        }
+
+        THEN("A discarded pending decode should not be decoded anymore") {
+            variant.discard_pending_decode();
+
+            REQUIRE(variant.get_type() == message_20::Type::DC_ChargeLoopReq);
+            REQUIRE(variant.get_if<message_20::DC_ChargeLoopRequest>() == nullptr);
+        }
+    }
+
+    GIVEN("A converted dc_charge_loop_req") {
+        message_20::DC_ChargeLoopRequest req;
+        req.header = message_20::Header{session_id, 1725456333};
+        req.meter_info_requested = true;
+        req.present_voltage = {400, 0};
+        req.control_mode.emplace<dt::Dynamic_DC_CLReqControlMode>();
+
+        variant.emplace(req);
+
+        THEN("The view should read the converted message") {
+            const auto view = variant.get_view<message_20::DC_ChargeLoopRequestView>();
+            REQUIRE(view.has_value());
+            REQUIRE(view->get_header().session_id == session_id);
+            REQUIRE(view->get_session_id() == session_id);
+            REQUIRE(view->get_meter_info_requested() == true);
+            REQUIRE(view->get_message().meter_info_requested == true);
+            REQUIRE(view->holds_control_mode<dt::Dynamic_DC_CLReqControlMode>());
+        }
+    }
+
+    GIVEN("A deferred ac_charge_loop_req") {
+        variant.defer_decode(io::v2gtp::PayloadType::Part20AC,
+                             {ac_charge_loop_req_raw, sizeof(ac_charge_loop_req_raw)}, codec);
+
+        THEN("The view should read the exi document") {
+            const auto view = variant.get_view<message_20::AC_ChargeLoopRequestView>();
+            REQUIRE(view.has_value());
+
+            const auto header = view->get_header();
+            REQUIRE(header.session_id == session_id);
+            REQUIRE(header.timestamp == 1725456333);
+            REQUIRE(view->get_session_id() == session_id);
+            REQUIRE(view->get_meter_info_requested() == false);
+
+            using ScheduledMode = dt::Scheduled_AC_CLReqControlMode;
+
+            REQUIRE(view->holds_control_mode<ScheduledMode>());
+
+            const auto control_mode = view->get_control_mode();
+            REQUIRE(std::holds_alternative<ScheduledMode>(control_mode));
+            REQUIRE(dt::from_RationalNumber(std::get<ScheduledMode>(control_mode).present_active_power) == 12000.0f);
+        }
+    }
+
+    GIVEN("A deferred dc_pre_charge_req") {
+        variant.defer_decode(io::v2gtp::PayloadType::Part20DC, {dc_pre_charge_req_raw, sizeof(dc_pre_charge_req_raw)},
+                             codec);
+
+        THEN("The view should read the exi document") {
+            const auto view = variant.get_view<message_20::DC_PreChargeRequestView>();
+            REQUIRE(view.has_value());
+
+            const auto header = view->get_header();
+            REQUIRE(header.session_id == session_id);
+            REQUIRE(header.timestamp == 1725456331);
+            REQUIRE(view->get_session_id() == session_id);
+            REQUIRE(view->get_processing() == dt::Processing::Ongoing);
+            REQUIRE(dt::from_RationalNumber(view->get_present_voltage()) == 400);
+            REQUIRE(dt::from_RationalNumber(view->get_target_voltage()) == 400);
+        }
+    }
+}
+
+TEST_CASE("Request view vs. conversion", "[.][benchmark]") {
+    message_20::CodecContext codec;
+    message_20::Variant variant;
+
+    const io::StreamInputView dc_charge_loop_req{dc_charge_loop_req_raw, sizeof(dc_charge_loop_req_raw)};
+
+    // both read what the charge loop state needs for its response
+    BENCHMARK("dc_charge_loop_req conversion") {
+        variant.decode(io::v2gtp::PayloadType::Part20DC, dc_charge_loop_req, codec);
+        const auto& msg = variant.get<message_20::DC_ChargeLoopRequest>();
+        return msg.header.timestamp + std::holds_alternative<dt::Scheduled_DC_CLReqControlMode>(msg.control_mode);
+    };
+
+    BENCHMARK("dc_charge_loop_req view") {
+        variant.defer_decode(io::v2gtp::PayloadType::Part20DC, dc_charge_loop_req, codec);
+        const auto view = variant.get_view<message_20::DC_ChargeLoopRequestView>();
+        return view->get_header().timestamp + view->holds_control_mode<dt::Scheduled_DC_CLReqControlMode>();
+    };
+
+    const io::StreamInputView ac_charge_loop_req{ac_charge_loop_req_raw, sizeof(ac_charge_loop_req_raw)};
+
+    BENCHMARK("ac_charge_loop_req conversion") {
+        variant.decode(io::v2gtp::PayloadType::Part20AC, ac_charge_loop_req, codec);
+        const auto& msg = variant.get<message_20::AC_ChargeLoopRequest>();
+        return msg.header.timestamp + std::holds_alternative<dt::Scheduled_AC_CLReqControlMode>(msg.control_mode);
+    };
+
+    BENCHMARK("ac_charge_loop_req view") {
+        variant.defer_decode(io::v2gtp::PayloadType::Part20AC, ac_charge_loop_req, codec);
+        const auto view = variant.get_view<message_20::AC_ChargeLoopRequestView>();
+        return view->get_header().timestamp + view->holds_control_mode<dt::Scheduled_AC_CLReqControlMode>();
+    };
+
+    const io::StreamInputView dc_pre_charge_req{dc_pre_charge_req_raw, sizeof(dc_pre_charge_req_raw)};
+
+    BENCHMARK("dc_pre_charge_req conversion") {
+        variant.decode(io::v2gtp::PayloadType::Part20DC, dc_pre_charge_req, codec);
+        const auto& msg = variant.get<message_20::DC_PreChargeRequest>();
+        return msg.header.timestamp + msg.target_voltage.value;
+    };
+
+    BENCHMARK("dc_pre_charge_req view") {
+        variant.defer_decode(io::v2gtp::PayloadType::Part20DC, dc_pre_charge_req, codec);
+        const auto view = variant.get_view<message_20::DC_PreChargeRequestView>();
+        return view->get_header().timestamp + view->get_target_voltage().value;
+    };
+}
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <iso15118/d20/control_event_queue.hpp>
+
+using namespace iso15118;
+
+static float get_voltage(const std::optional<d20::ControlEvent>& event) {
+    REQUIRE(event.has_value());
+    const auto* present = std::get_if<d20::PresentVoltageCurrent>(&*event);
+    REQUIRE(present != nullptr);
+    return present->voltage;
+}
+
+SCENARIO("Control event queue") {
+    GIVEN("An empty queue") {
+        d20::ControlEventQueue queue(3);
+
+        THEN("The capacity should be rounded up to a power of two") {
+            REQUIRE(queue.get_capacity() == 4);
+        }
+
+        THEN("Nothing should be popped") {
+            REQUIRE(queue.pop() == std::nullopt);
+        }
+
+        WHEN("Events are pushed") {
+            REQUIRE(queue.push(d20::PresentVoltageCurrent{1, 0}));
+            REQUIRE(queue.push(d20::StopCharging(true)));
+            REQUIRE(queue.push(d20::SupportedVASs{1, 2, 3}));
+
+            THEN("They should be popped in order") {
+                REQUIRE(get_voltage(queue.pop()) == 1);
+
+                const auto stop = queue.pop();
+                REQUIRE(stop.has_value());
+                REQUIRE(std::holds_alternative<d20::StopCharging>(*stop));
+
+                const auto vas = queue.pop();
+                REQUIRE(vas.has_value());
+                REQUIRE(std::get<d20::SupportedVASs>(*vas) == d20::SupportedVASs{1, 2, 3});
+
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+
+    GIVEN("A full queue, which drops the newest event") {
+        d20::ControlEventQueue queue(2, d20::ControlEventOverflowPolicy::DROP_NEWEST);
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{1, 0}));
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{2, 0}));
+
+        WHEN("Another event is pushed") {
+            const auto pushed = queue.push(d20::PresentVoltageCurrent{3, 0});
+
+            THEN("The new event should be discarded") {
+                REQUIRE_FALSE(pushed);
+                REQUIRE(queue.get_dropped_count() == 1);
+                REQUIRE(get_voltage(queue.pop()) == 1);
+                REQUIRE(get_voltage(queue.pop()) == 2);
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+
+    GIVEN("A full queue, which overwrites the oldest event") {
+        d20::ControlEventQueue queue(2, d20::ControlEventOverflowPolicy::OVERWRITE_OLDEST);
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{1, 0}));
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{2, 0}));
+
+        WHEN("Another event is pushed") {
+            const auto pushed = queue.push(d20::PresentVoltageCurrent{3, 0});
+
+            THEN("The oldest event should be discarded") {
+                REQUIRE_FALSE(pushed);
+                REQUIRE(queue.get_dropped_count() == 1);
+                REQUIRE(get_voltage(queue.pop()) == 2);
+                REQUIRE(get_voltage(queue.pop()) == 3);
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+
+    GIVEN("A full queue of state events") {
+        d20::ControlEventQueue queue(2, d20::ControlEventOverflowPolicy::DROP_NEWEST);
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{1, 0}));
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{2, 0}));
+
+        WHEN("More edge events than the capacity are pushed") {
+            REQUIRE(queue.push(d20::StopCharging(true)));
+            REQUIRE(queue.push(d20::ClosedContactor(true)));
+            REQUIRE(queue.push(d20::AuthorizationResponse(true)));
+            REQUIRE(queue.push(d20::PresentVoltageCurrent{3, 0}) == false);
+            REQUIRE(queue.push(d20::CableCheckFinished(true)));
+
+            THEN("No edge event should be discarded and all should stay in order") {
+                REQUIRE(queue.get_dropped_count() == 1);
+                REQUIRE(get_voltage(queue.pop()) == 1);
+                REQUIRE(get_voltage(queue.pop()) == 2);
+
+                for (const auto index : {d20::ControlEvent(d20::StopCharging(true)).index(),
+                                         d20::ControlEvent(d20::ClosedContactor(true)).index(),
+                                         d20::ControlEvent(d20::AuthorizationResponse(true)).index(),
+                                         d20::ControlEvent(d20::CableCheckFinished(true)).index()}) {
+                    const auto event = queue.pop();
+                    REQUIRE(event.has_value());
+                    REQUIRE(event->index() == index);
+                }
+
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+
+    GIVEN("A queue, which overwrites the oldest event, with edge events in between") {
+        d20::ControlEventQueue queue(2, d20::ControlEventOverflowPolicy::OVERWRITE_OLDEST);
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{1, 0}));
+        REQUIRE(queue.push(d20::StopCharging(true)));
+        REQUIRE(queue.push(d20::PresentVoltageCurrent{2, 0}));
+
+        WHEN("The ring overflows") {
+            REQUIRE_FALSE(queue.push(d20::PresentVoltageCurrent{3, 0}));
+
+            THEN("Only the oldest state event should be discarded") {
+                const auto stop = queue.pop();
+                REQUIRE(stop.has_value());
+                REQUIRE(std::holds_alternative<d20::StopCharging>(*stop));
+                REQUIRE(get_voltage(queue.pop()) == 2);
+                REQUIRE(get_voltage(queue.pop()) == 3);
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+
+    GIVEN("Several producer threads") {
+        constexpr auto PRODUCERS = 4;
+        constexpr auto EVENTS_PER_PRODUCER = 10000;
+        d20::ControlEventQueue queue(16, d20::ControlEventOverflowPolicy::DROP_NEWEST);
+
+        WHEN("All of them push events, retrying when the queue is full") {
+            std::vector<std::thread> producers;
+            for (auto producer = 0; producer < PRODUCERS; ++producer) {
+                producers.emplace_back([&queue, producer]() {
+                    for (auto i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                        while (not queue.push(d20::PresentVoltageCurrent{static_cast<float>(producer),
+                                                                         static_cast<float>(i)})) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            std::vector<int> next_expected(PRODUCERS, 0);
+            auto popped = 0;
+            auto in_order = true;
+            while (popped < PRODUCERS * EVENTS_PER_PRODUCER) {
+                const auto event = queue.pop();
+                if (not event) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto& present = std::get<d20::PresentVoltageCurrent>(*event);
+                auto& expected = next_expected.at(static_cast<std::size_t>(present.voltage));
+                in_order = in_order and (static_cast<int>(present.current) == expected);
+                expected++;
+                popped++;
+            }
+
+            for (auto& producer : producers) {
+                producer.join();
+            }
+
+            THEN("Every event should be popped once and in order per producer") {
+                REQUIRE(in_order);
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+
+    GIVEN("A producer thread mixing state and edge events") {
+        constexpr auto ROUNDS = 2000;
+        d20::ControlEventQueue queue(16, d20::ControlEventOverflowPolicy::DROP_NEWEST);
+
+        WHEN("Every state event is followed by an edge event, while the consumer is polling") {
+            // NOTE: the producer waits for the consumer to drain each round, so the pushes race with pop()
+            std::atomic<int> drained_rounds{0};
+            std::thread producer([&queue, &drained_rounds]() {
+                for (auto i = 0; i < ROUNDS; ++i) {
+                    while (drained_rounds.load() < i) {
+                        std::this_thread::yield();
+                    }
+                    queue.push(d20::PresentVoltageCurrent{0, static_cast<float>(i)});
+                    queue.push(d20::StopCharging(true));
+                }
+            });
+
+            auto out_of_order = 0;
+            for (auto i = 0; i < ROUNDS; ++i) {
+                auto state_event_popped = false;
+                while (true) {
+                    const auto event = queue.pop();
+                    if (not event) {
+                        continue;
+                    }
+
+                    if (std::holds_alternative<d20::StopCharging>(*event)) {
+                        // the state event pushed ahead of it needs to be popped already
+                        if (not state_event_popped) {
+                            out_of_order++;
+                        }
+                        break;
+                    }
+
+                    state_event_popped = true;
+                }
+
+                // the state event might still be queued, if it got overtaken
+                while (not state_event_popped) {
+                    state_event_popped = queue.pop().has_value();
+                }
+
+                drained_rounds++;
+            }
+
+            producer.join();
+
+            THEN("No edge event should overtake the state event pushed ahead of it") {
+                REQUIRE(out_of_order == 0);
+                REQUIRE(queue.pop() == std::nullopt);
+            }
+        }
+    }
+}
+
+SCENARIO("Control event classification for coalescing") {
+    THEN("Measurements and limits should be state events") {
+        REQUIRE(d20::is_state_control_event(d20::PresentVoltageCurrent{400, 10}));
+        REQUIRE(d20::is_state_control_event(d20::DcTransferLimits{}));
+        REQUIRE(d20::is_state_control_event(d20::AcPresentPower{}));
+    }
+
+    THEN("Everything else should be an edge event") {
+        REQUIRE_FALSE(d20::is_state_control_event(d20::StopCharging(true)));
+        REQUIRE_FALSE(d20::is_state_control_event(d20::AuthorizationResponse(true)));
+        REQUIRE_FALSE(d20::is_state_control_event(d20::ClosedContactor(true)));
+        REQUIRE_FALSE(d20::is_state_control_event(d20::CableCheckFinished(true)));
+    }
+}
+
+namespace {
+
+// the previous implementation, for comparison only
+class MutexControlEventQueue {
+public:
+    std::optional<d20::ControlEvent> pop() {
+        std::lock_guard<std::mutex> lck(mutex);
+
+        if (queue.empty()) {
+            return std::nullopt;
+        }
+
+        auto event = std::make_optional<d20::ControlEvent>(std::move(queue.front()));
+        queue.pop();
+
+        return event;
+    }
+
+    bool push(d20::ControlEvent event) {
+        std::lock_guard<std::mutex> lck(mutex);
+        queue.push(std::move(event));
+        return true;
+    }
+
+private:
+    std::queue<d20::ControlEvent> queue;
+    std::mutex mutex;
+};
+
+template <typename QueueType> int run_producers(QueueType& queue, int producer_count, int events_per_producer) {
+    std::vector<std::thread> producers;
+    for (auto producer = 0; producer < producer_count; ++producer) {
+        producers.emplace_back([&queue, events_per_producer]() {
+            for (auto i = 0; i < events_per_producer; ++i) {
+                while (not queue.push(d20::PresentVoltageCurrent{400, static_cast<float>(i)})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto popped = 0;
+    while (popped < producer_count * events_per_producer) {
+        if (queue.pop()) {
+            popped++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    return popped;
+}
+
+} // namespace
+
+TEST_CASE("Control event queue throughput", "[.][benchmark]") {
+    constexpr auto EVENTS_PER_PRODUCER = 1000;
+
+    for (const auto producer_count : {1, 2, 4, 8}) {
+        const auto suffix = " with " + std::to_string(producer_count) + " producers";
+
+        // NOTE: both queues are drained by every run, so they can be reused
+        MutexControlEventQueue mutex_queue;
+        BENCHMARK("mutex queue" + suffix) {
+            return run_producers(mutex_queue, producer_count, EVENTS_PER_PRODUCER);
+        };
+
+        // NOTE: large enough to hold all events, so only the push and pop costs are compared
+        d20::ControlEventQueue lock_free_queue(8 * EVENTS_PER_PRODUCER, d20::ControlEventOverflowPolicy::DROP_NEWEST);
+        BENCHMARK("lock-free queue" + suffix) {
+            return run_producers(lock_free_queue, producer_count, EVENTS_PER_PRODUCER);
+        };
+    }
+}
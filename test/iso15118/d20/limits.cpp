@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <iso15118/d20/limits.hpp>
+
+using namespace iso15118;
+
+namespace dt = message_20::datatypes;
+
+namespace {
+
+// the former implementations using the math library
+float reference_from_RationalNumber(const dt::RationalNumber& in) {
+    return in.value * pow(10, in.exponent);
+}
+
+dt::RationalNumber reference_from_float(float in) {
+    dt::RationalNumber out;
+    if (in == 0.0) {
+        out.exponent = 0;
+        out.value = 0;
+        return out;
+    }
+    out.exponent = static_cast<int8_t>(floor(log10(fabs(in))));
+    out.exponent -= 3; // add 3 digits of precision
+    out.value = static_cast<int16_t>(in * pow(10, -out.exponent));
+    return out;
+}
+
+long double to_long_double(const dt::RationalNumber& in) {
+    return in.value * std::pow(10.0L, in.exponent);
+}
+
+} // namespace
+
+namespace iso15118::message_20::datatypes {
+static bool operator==(const RationalNumber& lhs, const RationalNumber& rhs) {
+    return lhs.value == rhs.value and lhs.exponent == rhs.exponent;
+}
+} // namespace iso15118::message_20::datatypes
+
+SCENARIO("Rational number conversion") {
+
+    GIVEN("Floats over the whole range") {
+        // every 8191st positive float, including the denormals
+        std::size_t wrong_count = 0;
+        std::size_t less_accurate_count = 0;
+
+        for (uint32_t bits = 1; bits < 0x7f800000; bits += 8191) {
+            float positive;
+            std::memcpy(&positive, &bits, sizeof(positive));
+
+            for (const auto value : {positive, -positive}) {
+                const auto result = dt::from_float(value);
+
+                const auto error = std::fabs(to_long_double(result) - value);
+                const auto reference_error = std::fabs(to_long_double(reference_from_float(value)) - value);
+
+                // rounded to 4 significant digits
+                const auto abs_value = std::abs(result.value);
+                const auto half_unit = 0.5L * std::pow(10.0L, result.exponent);
+                if (abs_value < 1000 or abs_value > 9999 or error > half_unit * 1.000001L) {
+                    ++wrong_count;
+                }
+
+                if (error > reference_error * 1.000001L) {
+                    ++less_accurate_count;
+                }
+            }
+        }
+
+        THEN("They should be rounded to nearest and at least as accurate as before") {
+            REQUIRE(wrong_count == 0);
+            REQUIRE(less_accurate_count == 0);
+        }
+    }
+
+    GIVEN("All rational numbers with common exponents") {
+        std::size_t less_accurate_count = 0;
+        std::size_t round_trip_fail_count = 0;
+
+        for (int exponent = -6; exponent <= 6; ++exponent) {
+            for (int32_t value = INT16_MIN; value <= INT16_MAX; ++value) {
+                const dt::RationalNumber number{static_cast<int16_t>(value), static_cast<int8_t>(exponent)};
+
+                const auto exact = to_long_double(number);
+                const auto result = dt::from_RationalNumber(number);
+                const auto reference = reference_from_RationalNumber(number);
+
+                if (std::fabs(result - exact) > std::fabs(reference - exact)) {
+                    ++less_accurate_count;
+                }
+
+                const auto abs_value = std::abs(value);
+                if (abs_value >= 1000 and abs_value <= 9999 and not(dt::from_float(result) == number)) {
+                    ++round_trip_fail_count;
+                }
+            }
+        }
+
+        THEN("They should be at least as accurate as before and normalized ones should survive a round trip") {
+            REQUIRE(less_accurate_count == 0);
+            REQUIRE(round_trip_fail_count == 0);
+        }
+    }
+
+    GIVEN("Special values") {
+        THEN("They should be converted without overflow") {
+            REQUIRE(dt::from_float(0.0f) == dt::RationalNumber{0, 0});
+            REQUIRE(dt::from_float(std::numeric_limits<float>::quiet_NaN()) == dt::RationalNumber{0, 0});
+            REQUIRE(dt::from_float(std::numeric_limits<float>::infinity()) == dt::RationalNumber{32767, 127});
+            REQUIRE(dt::from_float(-std::numeric_limits<float>::infinity()) == dt::RationalNumber{-32768, 127});
+
+            REQUIRE(dt::from_float(400.0f) == dt::RationalNumber{4000, -1});
+            REQUIRE(dt::from_float(0.3f) == dt::RationalNumber{3000, -4});
+            REQUIRE(dt::from_float(9999.6f) == dt::RationalNumber{1000, 1});
+            REQUIRE(dt::from_float(std::numeric_limits<float>::max()) == dt::RationalNumber{3403, 35});
+
+            REQUIRE(dt::from_RationalNumber({1, 127}) == std::numeric_limits<float>::infinity());
+            REQUIRE(dt::from_RationalNumber({-1, 127}) == -std::numeric_limits<float>::infinity());
+            REQUIRE(dt::from_RationalNumber({32767, -128}) == 0.0f);
+        }
+    }
+}
+
+SCENARIO("Limits conversion") {
+    GIVEN("DC transfer limit values") {
+        d20::DcTransferLimitValues values;
+        values.charge_limits = {{22000, 0}, {50, 0}};
+        values.voltage = {900, 150};
+        values.power_ramp_limit = 1.5f;
+
+        const auto limits = d20::convert_limits(values);
+
+        THEN("All values should be converted") {
+            REQUIRE(limits.charge_limits.power.max == dt::RationalNumber{2200, 1});
+            REQUIRE(limits.charge_limits.power.min == dt::RationalNumber{0, 0});
+            REQUIRE(limits.charge_limits.current.max == dt::RationalNumber{5000, -2});
+            REQUIRE(limits.voltage.max == dt::RationalNumber{9000, -1});
+            REQUIRE(limits.voltage.min == dt::RationalNumber{1500, -1});
+            REQUIRE(limits.discharge_limits.has_value() == false);
+            REQUIRE(limits.power_ramp_limit.has_value());
+            REQUIRE(*limits.power_ramp_limit == dt::RationalNumber{1500, -3});
+        }
+    }
+
+    GIVEN("AC transfer limit values") {
+        d20::AcTransferLimitValues values;
+        values.charge_power = {11000, 0};
+        values.charge_power_L2 = {{11000, 0}};
+        values.nominal_frequency = 50;
+        values.discharge_power_L3 = {{-11000, 0}};
+
+        const auto limits = d20::convert_limits(values);
+
+        THEN("All values should be converted") {
+            REQUIRE(limits.charge_power.max == dt::RationalNumber{1100, 1});
+            REQUIRE(limits.charge_power_L2.has_value());
+            REQUIRE(limits.charge_power_L2->max == dt::RationalNumber{1100, 1});
+            REQUIRE(limits.charge_power_L3.has_value() == false);
+            REQUIRE(limits.nominal_frequency == dt::RationalNumber{5000, -2});
+            REQUIRE(limits.max_power_asymmetry.has_value() == false);
+            REQUIRE(limits.discharge_power.has_value() == false);
+            REQUIRE(limits.discharge_power_L3.has_value());
+            REQUIRE(limits.discharge_power_L3->max == dt::RationalNumber{-1100, 1});
+        }
+    }
+}
+
+TEST_CASE("Rational number conversion", "[.][benchmark]") {
+    std::vector<float> values;
+    for (int i = 1; i <= 1000; ++i) {
+        values.push_back(i * 0.731f);
+    }
+
+    std::vector<dt::RationalNumber> numbers(values.size());
+
+    BENCHMARK("reference_from_float") {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            numbers[i] = reference_from_float(values[i]);
+        }
+        return numbers.back().value;
+    };
+
+    BENCHMARK("from_float") {
+        dt::from_float(values.data(), numbers.data(), values.size());
+        return numbers.back().value;
+    };
+
+    BENCHMARK("reference_from_RationalNumber") {
+        for (std::size_t i = 0; i < numbers.size(); ++i) {
+            values[i] = reference_from_RationalNumber(numbers[i]);
+        }
+        return values.back();
+    };
+
+    BENCHMARK("from_RationalNumber") {
+        dt::from_RationalNumber(numbers.data(), values.data(), numbers.size());
+        return values.back();
+    };
+
+    d20::DcTransferLimitValues limit_values;
+    limit_values.charge_limits = {{22000, 0}, {50, 0}};
+    limit_values.discharge_limits = {{{22000, 0}, {50, 0}}};
+    limit_values.voltage = {900, 150};
+
+    BENCHMARK("convert_limits") {
+        return d20::convert_limits(limit_values);
+    };
+}
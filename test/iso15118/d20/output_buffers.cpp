@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <iso15118/d20/context.hpp>
+#include <iso15118/d20/output_buffers.hpp>
+#include <iso15118/message/service_discovery.hpp>
+
+using namespace iso15118;
+
+namespace dt = message_20::datatypes;
+
+static message_20::ServiceDiscoveryResponse create_response() {
+    message_20::ServiceDiscoveryResponse res;
+    res.header = {{0x2E, 0xFA, 0x18, 0x94, 0xDC, 0x7B, 0x90, 0x11}, 1739635913};
+    res.response_code = dt::ResponseCode::OK;
+    res.energy_transfer_service_list = {{dt::ServiceCategory::DC, false}, {dt::ServiceCategory::DC_BPT, false}};
+    return res;
+}
+
+SCENARIO("Output buffer pool") {
+    GIVEN("A pool reserving a header") {
+        d20::OutputBufferPool pool(8);
+
+        THEN("Each size class should reserve the header in front of its payload") {
+            for (std::size_t i = 0; i < d20::OutputBufferPool::SIZE_CLASS_COUNT; ++i) {
+                const auto view = pool.get_payload_view(i);
+                REQUIRE(view.payload != nullptr);
+                REQUIRE(view.payload_len == d20::OutputBufferPool::SIZE_CLASSES[i] - 8);
+            }
+        }
+
+        THEN("A buffer should be kept once it has been allocated") {
+            REQUIRE(pool.get_payload_view(2).payload == pool.get_payload_view(2).payload);
+        }
+
+        THEN("An unknown size class should be rejected") {
+            REQUIRE_THROWS_AS(pool.get_payload_view(d20::OutputBufferPool::SIZE_CLASS_COUNT), std::out_of_range);
+        }
+    }
+
+    GIVEN("A header not fitting into the smallest buffer") {
+        THEN("The pool should not be created") {
+            REQUIRE_THROWS_AS(d20::OutputBufferPool(d20::OutputBufferPool::SIZE_CLASSES.front()),
+                              std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("Encoded size statistics") {
+    GIVEN("Some encoded responses") {
+        d20::EncodedSizeStatistics stats;
+        stats.add(message_20::Type::ServiceDiscoveryRes, 100, 0);
+        stats.add(message_20::Type::ServiceDiscoveryRes, 3000, 1);
+        stats.add(message_20::Type::SessionSetupRes, 50, 0);
+
+        THEN("They should be accounted per message type") {
+            const auto& entry = stats.get(message_20::Type::ServiceDiscoveryRes);
+            REQUIRE(entry.count == 2);
+            REQUIRE(entry.max_size == 3000);
+            REQUIRE(entry.total_size == 3100);
+            REQUIRE(entry.size_class_counts[0] == 1);
+            REQUIRE(entry.size_class_counts[1] == 1);
+
+            REQUIRE(stats.get(message_20::Type::SessionSetupRes).count == 1);
+            REQUIRE(stats.get(message_20::Type::ServiceDetailRes).count == 0);
+        }
+    }
+}
+
+SCENARIO("Encoding responses into the output buffers") {
+    const auto res = create_response();
+
+    std::vector<uint8_t> expected(1024);
+    expected.resize(message_20::serialize(res, {expected.data(), expected.size()}));
+
+    GIVEN("A message exchange using a pool") {
+        d20::OutputBufferPool pool(8);
+        d20::MessageExchange message_exchange(pool);
+
+        message_exchange.set_response(res);
+
+        THEN("A small response should be encoded into the smallest buffer") {
+            const auto [got_response, size, payload_type, type] = message_exchange.check_and_clear_response();
+            REQUIRE(got_response);
+            REQUIRE(type == message_20::Type::ServiceDiscoveryRes);
+
+            const auto& view = message_exchange.get_response_view();
+            REQUIRE(view.payload == pool.get_payload_view(0).payload);
+            REQUIRE(std::vector<uint8_t>(view.payload, view.payload + size) == expected);
+
+            const auto& entry = message_exchange.get_encoded_size_stats().get(message_20::Type::ServiceDiscoveryRes);
+            REQUIRE(entry.count == 1);
+            REQUIRE(entry.max_size == expected.size());
+            REQUIRE(entry.size_class_counts[0] == 1);
+        }
+    }
+
+    GIVEN("A message exchange with a fixed output, which is too small") {
+        std::vector<uint8_t> buffer(expected.size() / 2);
+        d20::MessageExchange message_exchange({buffer.data(), buffer.size()});
+
+        THEN("Encoding the response should fail with an overflow") {
+            REQUIRE_THROWS_AS(message_exchange.set_response(res), message_20::EncodingBufferOverflow);
+
+            const auto [got_response, size, payload_type, type] = message_exchange.check_and_clear_response();
+            REQUIRE_FALSE(got_response);
+        }
+    }
+}
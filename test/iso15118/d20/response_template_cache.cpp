@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include <iso15118/d20/response_template_cache.hpp>
+#include <iso15118/message/codec_context.hpp>
+#include <iso15118/message/service_discovery.hpp>
+
+using namespace iso15118;
+
+namespace dt = message_20::datatypes;
+
+static message_20::ServiceDiscoveryResponse create_response(const message_20::Header& header) {
+    message_20::ServiceDiscoveryResponse res;
+    res.header = header;
+    res.response_code = dt::ResponseCode::OK;
+    res.energy_transfer_service_list = {{dt::ServiceCategory::DC, false}, {dt::ServiceCategory::DC_BPT, false}};
+    res.vas_list = dt::VasServiceList{{3, false}, {4, true}};
+    return res;
+}
+
+static std::vector<uint8_t> serialize(const message_20::ServiceDiscoveryResponse& res) {
+    std::vector<uint8_t> buffer(1024);
+    buffer.resize(message_20::serialize(res, {buffer.data(), buffer.size()}));
+    return buffer;
+}
+
+static std::vector<uint8_t> encode(d20::ResponseTemplateCache& cache, const message_20::ServiceDiscoveryResponse& res,
+                                   uint32_t key, message_20::CodecContext& codec) {
+    std::vector<uint8_t> buffer(1024);
+    buffer.resize(cache.encode(res, key, {buffer.data(), buffer.size()}, codec));
+    return buffer;
+}
+
+SCENARIO("Response template cache") {
+    d20::ResponseTemplateCache cache;
+    message_20::CodecContext codec;
+
+    const auto first = create_response({{0x2E, 0xFA, 0x18, 0x94, 0xDC, 0x7B, 0x90, 0x11}, 1739635913});
+    const auto second = create_response({{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08}, 1739636001});
+
+    GIVEN("An empty cache") {
+        THEN("The response should be encoded as usual") {
+            REQUIRE(encode(cache, first, 0, codec) == serialize(first));
+            REQUIRE(cache.size() == 1);
+        }
+    }
+
+    GIVEN("A cached response") {
+        encode(cache, first, 0, codec);
+
+        THEN("A response with another header should be patched from the template") {
+            REQUIRE(encode(cache, second, 0, codec) == serialize(second));
+            REQUIRE(cache.size() == 1);
+        }
+
+        THEN("A timestamp with another encoded length should still be encoded correctly") {
+            const auto early = create_response({{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}, 42});
+            REQUIRE(encode(cache, early, 0, codec) == serialize(early));
+        }
+
+        THEN("Another key should get its own template") {
+            auto other = create_response(second.header);
+            other.vas_list.reset();
+
+            REQUIRE(encode(cache, other, 1, codec) == serialize(other));
+            REQUIRE(cache.size() == 2);
+        }
+    }
+}
+
+TEST_CASE("Response template vs. full encoding", "[.][benchmark]") {
+    d20::ResponseTemplateCache cache;
+    message_20::CodecContext codec;
+    std::vector<uint8_t> buffer(1024);
+
+    auto res = create_response({{0x2E, 0xFA, 0x18, 0x94, 0xDC, 0x7B, 0x90, 0x11}, 1739635913});
+    cache.encode(res, 0, {buffer.data(), buffer.size()}, codec);
+
+    BENCHMARK("full encoding") {
+        res.header.timestamp++;
+        return message_20::serialize(res, {buffer.data(), buffer.size()}, codec);
+    };
+
+    BENCHMARK("patched template") {
+        res.header.timestamp++;
+        return cache.encode(res, 0, {buffer.data(), buffer.size()}, codec);
+    };
+}
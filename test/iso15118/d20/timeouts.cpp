@@ -74,4 +74,31 @@ SCENARIO("Timeouts Tests") {
         REQUIRE(reached.at(1) == iso15118::d20::TimeoutType::CONTACTOR);
         REQUIRE(reached.at(2) == iso15118::d20::TimeoutType::SEQUENCE);
     }
-}
\ No newline at end of file
+
+    GIVEN("Next deadline of multiple timeouts") {
+        auto timeouts = iso15118::d20::Timeouts{};
+
+        REQUIRE(timeouts.get_next_deadline().has_value() == false);
+
+        const auto before = iso15118::get_current_time_point();
+        timeouts.start_timeout(iso15118::d20::TimeoutType::SEQUENCE, 3000);
+        timeouts.start_timeout(iso15118::d20::TimeoutType::PERFORMANCE, 1000);
+        timeouts.start_timeout(iso15118::d20::TimeoutType::CONTACTOR, 2000);
+        const auto after = iso15118::get_current_time_point();
+
+        auto next_deadline = timeouts.get_next_deadline();
+        REQUIRE(next_deadline.has_value());
+        REQUIRE(next_deadline.value() >= iso15118::offset_time_point_by_ms(before, 1000));
+        REQUIRE(next_deadline.value() <= iso15118::offset_time_point_by_ms(after, 1000));
+
+        timeouts.stop_timeout(iso15118::d20::TimeoutType::PERFORMANCE);
+        next_deadline = timeouts.get_next_deadline();
+        REQUIRE(next_deadline.has_value());
+        REQUIRE(next_deadline.value() >= iso15118::offset_time_point_by_ms(before, 2000));
+        REQUIRE(next_deadline.value() <= iso15118::offset_time_point_by_ms(after, 2000));
+
+        timeouts.reset_timeout(iso15118::d20::TimeoutType::SEQUENCE);
+        timeouts.reset_timeout(iso15118::d20::TimeoutType::CONTACTOR);
+        REQUIRE(timeouts.get_next_deadline().has_value() == false);
+    }
+}
@@ -92,7 +92,8 @@ int main(int argc, char** argv) {
                                 false,   // enforce_tls_1_3
                                 "/tmp"}; // tls_key_log_file_path
 
-    auto connection = io::ConnectionSSL(poll_manager, interface_name, ssl);
+    const io::SSLServerContext ssl_server_context(ssl);
+    auto connection = io::ConnectionSSL(poll_manager, interface_name, ssl_server_context);
     connection.set_event_callback([](io::ConnectionEvent event) { handle_connection_event(event); });
 
     auto next_event = get_current_time_point();
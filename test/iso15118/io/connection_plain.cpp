@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <iso15118/io/connection_plain.hpp>
+#include <iso15118/io/logging.hpp>
+#include <iso15118/io/poll_manager.hpp>
+#include <iso15118/io/time.hpp>
+
+using namespace iso15118;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto PORT = 50000;
+constexpr auto LINGER_MS = 300;
+// NOTE: the time ConnectionPlain waits for the FIN of the peer after its own one
+constexpr auto WAIT_FOR_FIN_TIMEOUT_MS = 2000;
+
+// EV side of the connection
+struct Client {
+    Client() {
+        fd = socket(AF_INET6, SOCK_STREAM, 0);
+
+        sockaddr_in6 address{};
+        address.sin6_family = AF_INET6;
+        address.sin6_port = htons(PORT);
+        address.sin6_addr = in6addr_loopback;
+
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            throw std::runtime_error("Failed to connect");
+        }
+    }
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    ~Client() {
+        close(fd);
+    }
+
+    // true, once the FIN of the other side arrived
+    bool received_fin() const {
+        char tmp;
+        return recv(fd, &tmp, sizeof(tmp), MSG_DONTWAIT) == 0;
+    }
+
+    void send_fin() {
+        shutdown(fd, SHUT_WR);
+    }
+
+    int fd{-1};
+};
+
+// polls until the predicate holds, returns false on timeout
+bool poll_until(io::PollManager& poll_manager, const std::function<bool()>& predicate, int timeout_ms) {
+    const auto deadline = offset_time_point_by_ms(get_current_time_point(), timeout_ms);
+
+    while (not predicate()) {
+        if (get_current_time_point() >= deadline) {
+            return false;
+        }
+        poll_manager.poll(10);
+    }
+
+    return true;
+}
+
+int64_t ms_since(const TimePoint& start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(get_current_time_point() - start).count();
+}
+
+} // namespace
+
+SCENARIO("Teardown of a plain connection") {
+    io::set_logging_callback([](LogLevel, const std::string&) {});
+
+    GIVEN("An open connection on the loopback interface") {
+        io::PollManager poll_manager;
+        io::ConnectionPlain connection(poll_manager, "lo");
+
+        std::vector<io::ConnectionEvent> events;
+        connection.set_event_callback([&events](io::ConnectionEvent event) { events.push_back(event); });
+
+        const auto count = [&events](io::ConnectionEvent event) {
+            return std::count(events.begin(), events.end(), event);
+        };
+        const auto closed = [&count]() { return count(io::ConnectionEvent::CLOSED) > 0; };
+
+        Client client;
+        REQUIRE(poll_until(poll_manager, [&count]() { return count(io::ConnectionEvent::OPEN) > 0; }, 1000));
+
+        WHEN("It is closed with a linger time") {
+            const auto closing = get_current_time_point();
+            connection.linger_and_close(LINGER_MS);
+
+            THEN("The loop should keep running while lingering") {
+                bool timer_fired{false};
+                poll_manager.schedule_timer(offset_time_point_by_ms(closing, LINGER_MS / 3),
+                                            [&timer_fired]() { timer_fired = true; });
+
+                REQUIRE(poll_until(poll_manager, [&timer_fired]() { return timer_fired; }, LINGER_MS));
+                REQUIRE_FALSE(closed());
+                REQUIRE_FALSE(client.received_fin());
+            }
+
+            AND_WHEN("The peer closes its side while lingering") {
+                client.send_fin();
+
+                THEN("It should be closed right away") {
+                    REQUIRE(poll_until(poll_manager, closed, LINGER_MS));
+                    REQUIRE(ms_since(closing) < LINGER_MS);
+                    REQUIRE(count(io::ConnectionEvent::CLOSED) == 1);
+                    REQUIRE(client.received_fin());
+                }
+            }
+
+            AND_WHEN("The peer answers the FIN sent after the linger time") {
+                REQUIRE(poll_until(poll_manager, [&client]() { return client.received_fin(); }, 2 * LINGER_MS));
+                REQUIRE(ms_since(closing) >= LINGER_MS);
+                REQUIRE_FALSE(closed());
+
+                const auto fin_sent = get_current_time_point();
+                client.send_fin();
+
+                THEN("It should be closed without waiting for the timeout") {
+                    REQUIRE(poll_until(poll_manager, closed, WAIT_FOR_FIN_TIMEOUT_MS));
+                    REQUIRE(ms_since(fin_sent) < WAIT_FOR_FIN_TIMEOUT_MS / 2);
+                    REQUIRE(count(io::ConnectionEvent::CLOSED) == 1);
+                }
+            }
+
+            AND_WHEN("The peer never closes its side") {
+                THEN("It should be closed after the timeout") {
+                    REQUIRE(poll_until(poll_manager, closed, LINGER_MS + 2 * WAIT_FOR_FIN_TIMEOUT_MS));
+                    REQUIRE(ms_since(closing) >= LINGER_MS + WAIT_FOR_FIN_TIMEOUT_MS);
+                    REQUIRE(count(io::ConnectionEvent::CLOSED) == 1);
+                    REQUIRE(client.received_fin());
+                }
+            }
+        }
+
+        WHEN("It is closed without a linger time") {
+            connection.close();
+
+            THEN("The FIN should be sent right away") {
+                REQUIRE(poll_until(poll_manager, [&client]() { return client.received_fin(); }, 100));
+                REQUIRE_FALSE(closed());
+            }
+
+            AND_WHEN("The peer closes its side") {
+                client.send_fin();
+
+                THEN("It should be closed") {
+                    REQUIRE(poll_until(poll_manager, closed, WAIT_FOR_FIN_TIMEOUT_MS / 2));
+                    REQUIRE(count(io::ConnectionEvent::CLOSED) == 1);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <iso15118/io/event_loop.hpp>
+#include <iso15118/io/time.hpp>
+
+using namespace iso15118;
+using namespace std::chrono_literals;
+
+SCENARIO("Event loop") {
+    GIVEN("A loop running within its own worker thread") {
+        // NOTE: declared ahead of the loop, because its thread uses them until the loop is gone
+        std::promise<std::thread::id> loop_thread_promise;
+        bool loop_thread_known{false};
+
+        io::EventLoop loop;
+        loop.start([&]() {
+            if (not loop_thread_known) {
+                loop_thread_known = true;
+                loop_thread_promise.set_value(std::this_thread::get_id());
+            }
+        });
+        const auto loop_thread = loop_thread_promise.get_future().get();
+
+        THEN("The loop should not run within the calling thread") {
+            REQUIRE(loop_thread != std::this_thread::get_id());
+        }
+
+        WHEN("A task is posted") {
+            std::promise<std::thread::id> task_thread;
+            loop.post([&task_thread]() { task_thread.set_value(std::this_thread::get_id()); });
+
+            THEN("It should run within the thread of the loop") {
+                auto result = task_thread.get_future();
+                REQUIRE(result.wait_for(5s) == std::future_status::ready);
+                REQUIRE(result.get() == loop_thread);
+            }
+        }
+
+        WHEN("Several tasks are posted from different threads") {
+            std::vector<int> order;
+            std::promise<void> done;
+
+            std::thread other([&loop, &order]() {
+                for (int i = 0; i < 5; ++i) {
+                    loop.post([&order, i]() { order.push_back(i); });
+                }
+            });
+            other.join();
+
+            for (int i = 5; i < 10; ++i) {
+                loop.post([&order, i]() { order.push_back(i); });
+            }
+            loop.post([&done]() { done.set_value(); });
+
+            THEN("They should run in the order they have been posted") {
+                REQUIRE(done.get_future().wait_for(5s) == std::future_status::ready);
+                REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+            }
+        }
+
+        WHEN("A timer is scheduled from within a task") {
+            std::promise<std::thread::id> timer_thread;
+            loop.post([&loop, &timer_thread]() {
+                loop.get_poll_manager().schedule_timer(
+                    offset_time_point_by_ms(get_current_time_point(), 10),
+                    [&timer_thread]() { timer_thread.set_value(std::this_thread::get_id()); });
+            });
+
+            THEN("It should fire within the thread of the loop") {
+                auto result = timer_thread.get_future();
+                REQUIRE(result.wait_for(5s) == std::future_status::ready);
+                REQUIRE(result.get() == loop_thread);
+            }
+        }
+
+        WHEN("A task fails") {
+            loop.post([]() { throw std::runtime_error("failed"); });
+
+            THEN("The loop should be marked as failed") {
+                const auto deadline = offset_time_point_by_ms(get_current_time_point(), 5000);
+                while (not loop.has_failed() and get_current_time_point() < deadline) {
+                    std::this_thread::sleep_for(1ms);
+                }
+                REQUIRE(loop.has_failed());
+            }
+        }
+
+        WHEN("The loop is stopped") {
+            loop.stop();
+
+            THEN("Stopping it again should be fine") {
+                loop.stop();
+                REQUIRE_FALSE(loop.has_failed());
+            }
+        }
+    }
+
+    GIVEN("A loop sharing the poll manager of the calling thread") {
+        io::PollManager poll_manager;
+        io::EventLoop loop(poll_manager);
+
+        WHEN("A task is posted from another thread") {
+            std::thread::id task_thread;
+            std::thread other([&loop, &task_thread]() {
+                loop.post([&loop, &task_thread]() {
+                    task_thread = std::this_thread::get_id();
+                    loop.stop();
+                });
+            });
+            other.join();
+
+            int wakeups{0};
+            loop.run([&wakeups]() { wakeups++; });
+
+            THEN("It should run within the thread calling run()") {
+                REQUIRE(task_thread == std::this_thread::get_id());
+                REQUIRE(wakeups == 1);
+            }
+        }
+    }
+}
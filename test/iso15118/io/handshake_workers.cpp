@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <iso15118/io/connection_ssl.hpp>
+#include <iso15118/io/logging.hpp>
+#include <iso15118/io/poll_manager.hpp>
+#include <iso15118/io/time.hpp>
+#include <iso15118/io/worker_pool.hpp>
+
+using namespace iso15118;
+using namespace std::chrono_literals;
+
+SCENARIO("Worker pool") {
+    GIVEN("A pool with a single thread") {
+        io::WorkerPool pool(1);
+
+        THEN("The tasks should run in the order they have been posted") {
+            std::vector<int> order;
+            std::vector<std::future<void>> results;
+            for (int i = 0; i < 10; ++i) {
+                results.push_back(pool.post([&order, i]() { order.push_back(i); }));
+            }
+
+            for (auto& result : results) {
+                result.wait();
+            }
+
+            REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+        }
+
+        THEN("A throwing task should be reported by its future") {
+            auto result = pool.post([]() { throw std::runtime_error("failed"); });
+            REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+
+            // the thread is still available
+            pool.post([]() {}).get();
+        }
+    }
+
+    GIVEN("A pool with several threads") {
+        std::atomic<int> count{0};
+
+        {
+            io::WorkerPool pool(4);
+            REQUIRE(pool.get_thread_count() == 4);
+
+            for (int i = 0; i < 100; ++i) {
+                pool.post([&count]() { count++; });
+            }
+        }
+
+        THEN("All posted tasks should have run, once the pool is gone") {
+            REQUIRE(count == 100);
+        }
+    }
+
+    GIVEN("A pool without threads") {
+        THEN("It should not be created") {
+            REQUIRE_THROWS_AS(io::WorkerPool(0), std::invalid_argument);
+        }
+    }
+}
+
+namespace {
+
+constexpr auto TLS_PORT = 50000;
+constexpr auto HANDSHAKES = 20;
+constexpr auto CHARGE_LOOP_INTERVAL_MS = 2;
+
+struct Pki {
+    std::filesystem::path certificate;
+    std::filesystem::path key;
+};
+
+// self signed secp521r1 certificate, like the ones of ISO 15118-20
+Pki create_pki(const std::filesystem::path& directory) {
+    std::filesystem::create_directories(directory);
+    Pki pki{directory / "cert.pem", directory / "key.pem"};
+
+    const auto key = EVP_EC_gen("secp521r1");
+    const auto cert = X509_new();
+
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+
+    const auto name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("benchmark"), -1, -1,
+                               0);
+    X509_set_issuer_name(cert, name);
+    X509_sign(cert, key, EVP_sha512());
+
+    const auto cert_file = fopen(pki.certificate.c_str(), "w");
+    PEM_write_X509(cert_file, cert);
+    fclose(cert_file);
+
+    const auto key_file = fopen(pki.key.c_str(), "w");
+    PEM_write_PrivateKey(key_file, key, nullptr, nullptr, 0, nullptr, nullptr);
+    fclose(key_file);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+
+    return pki;
+}
+
+// EV side, connects once per round and waits for the server to close the connection
+void run_clients(const Pki& pki, const std::atomic<int>& listening_round, std::atomic<bool>& abort) {
+    const auto ctx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_use_certificate_file(ctx, pki.certificate.c_str(), SSL_FILETYPE_PEM);
+    SSL_CTX_use_PrivateKey_file(ctx, pki.key.c_str(), SSL_FILETYPE_PEM);
+
+    sockaddr_in6 address{};
+    address.sin6_family = AF_INET6;
+    address.sin6_port = htons(TLS_PORT);
+    address.sin6_addr = in6addr_loopback;
+
+    for (int round = 0; round < HANDSHAKES and not abort; ++round) {
+        while (listening_round < round and not abort) {
+            std::this_thread::sleep_for(100us);
+        }
+
+        const auto fd = socket(AF_INET6, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            break;
+        }
+
+        const auto ssl = SSL_new(ctx);
+        SSL_set_fd(ssl, fd);
+        if (SSL_connect(ssl) == 1) {
+            char buffer;
+            while (SSL_read(ssl, &buffer, sizeof(buffer)) > 0) {
+            }
+        }
+
+        SSL_free(ssl);
+        close(fd);
+    }
+
+    SSL_CTX_free(ctx);
+}
+
+struct LatencyResult {
+    int handshakes;
+    int64_t max_us;
+    int64_t p99_us;
+    int64_t mean_us;
+};
+
+// runs the handshakes within the same event loop as a periodic charge loop and measures how late its ticks are
+LatencyResult measure_charge_loop_latency(const Pki& pki, uint32_t handshake_worker_threads) {
+    config::SSLConfig ssl_config{config::CertificateBackend::EVEREST_LAYOUT,
+                                 {},
+                                 pki.certificate.string(),
+                                 pki.key.string(),
+                                 {},
+                                 pki.certificate.string(),
+                                 pki.certificate.string()};
+    ssl_config.handshake_worker_threads = handshake_worker_threads;
+
+    const io::SSLServerContext server_context(ssl_config);
+    io::PollManager poll_manager;
+
+    std::vector<int64_t> latencies;
+    auto next_tick = get_current_time_point();
+    std::function<void()> tick = [&]() {
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(get_current_time_point() - next_tick).count());
+        next_tick = offset_time_point_by_ms(next_tick, CHARGE_LOOP_INTERVAL_MS);
+        poll_manager.schedule_timer(next_tick, tick);
+    };
+    next_tick = offset_time_point_by_ms(next_tick, CHARGE_LOOP_INTERVAL_MS);
+    poll_manager.schedule_timer(next_tick, tick);
+
+    std::atomic<int> listening_round{-1};
+    std::atomic<bool> abort{false};
+    int handshakes{0};
+    bool connection_closed{false};
+
+    std::unique_ptr<io::ConnectionSSL> connection;
+    const auto listen = [&]() {
+        connection = std::make_unique<io::ConnectionSSL>(poll_manager, "lo", server_context);
+        connection->set_event_callback([&](io::ConnectionEvent event) {
+            if (event == io::ConnectionEvent::OPEN) {
+                handshakes++;
+                connection->close();
+            } else if (event == io::ConnectionEvent::CLOSED) {
+                connection_closed = true;
+            }
+        });
+        listening_round++;
+    };
+
+    std::thread clients(run_clients, std::cref(pki), std::cref(listening_round), std::ref(abort));
+
+    listen();
+    const auto deadline = offset_time_point_by_ms(get_current_time_point(), 30000);
+
+    while (handshakes < HANDSHAKES and get_current_time_point() < deadline) {
+        poll_manager.poll(CHARGE_LOOP_INTERVAL_MS);
+
+        if (connection_closed) {
+            // NOTE: the connection can't be destroyed from within its own callback
+            connection_closed = false;
+            connection.reset();
+            if (handshakes < HANDSHAKES) {
+                listen();
+            }
+        }
+    }
+
+    abort = true;
+    clients.join();
+    connection.reset();
+
+    std::sort(latencies.begin(), latencies.end());
+
+    LatencyResult result{handshakes, 0, 0, 0};
+    if (not latencies.empty()) {
+        result.max_us = latencies.back();
+        result.p99_us = latencies[latencies.size() * 99 / 100];
+        int64_t sum = 0;
+        for (const auto latency : latencies) {
+            sum += latency;
+        }
+        result.mean_us = sum / static_cast<int64_t>(latencies.size());
+    }
+
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Charge loop latency during tls handshakes", "[.][benchmark]") {
+    io::set_logging_callback([](LogLevel, const std::string&) {});
+
+    const auto pki = create_pki(std::filesystem::temp_directory_path() / "iso15118_handshake_benchmark");
+
+    for (const auto workers : {0u, 2u}) {
+        const auto result = measure_charge_loop_latency(pki, workers);
+
+        std::printf("%-28s handshakes: %2d, charge loop tick latency mean: %5ld us, p99: %5ld us, max: %5ld us\n",
+                    workers == 0 ? "handshakes within the loop:" : "handshakes within workers:", result.handshakes,
+                    static_cast<long>(result.mean_us), static_cast<long>(result.p99_us),
+                    static_cast<long>(result.max_us));
+
+        REQUIRE(result.handshakes == HANDSHAKES);
+    }
+
+    std::filesystem::remove_all(std::filesystem::temp_directory_path() / "iso15118_handshake_benchmark");
+}
+
+SCENARIO("Failed tls handshakes") {
+    io::set_logging_callback([](LogLevel, const std::string&) {});
+
+    const auto directory = std::filesystem::temp_directory_path() / "iso15118_failed_handshake";
+    const auto pki = create_pki(directory);
+
+    for (const auto workers : {0u, 2u}) {
+        GIVEN("A tls connection with " + std::to_string(workers) + " handshake workers") {
+            config::SSLConfig ssl_config{config::CertificateBackend::EVEREST_LAYOUT,
+                                         {},
+                                         pki.certificate.string(),
+                                         pki.key.string(),
+                                         {},
+                                         pki.certificate.string(),
+                                         pki.certificate.string()};
+            ssl_config.handshake_worker_threads = workers;
+
+            const io::SSLServerContext server_context(ssl_config);
+            io::PollManager poll_manager;
+
+            io::ConnectionSSL connection(poll_manager, "lo", server_context);
+            bool connection_closed{false};
+            connection.set_event_callback([&connection_closed](io::ConnectionEvent event) {
+                if (event == io::ConnectionEvent::CLOSED) {
+                    connection_closed = true;
+                }
+            });
+
+            WHEN("The peer sends something else than a client hello") {
+                sockaddr_in6 address{};
+                address.sin6_family = AF_INET6;
+                address.sin6_port = htons(TLS_PORT);
+                address.sin6_addr = in6addr_loopback;
+
+                const auto fd = socket(AF_INET6, SOCK_STREAM, 0);
+                REQUIRE(connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+                const char garbage[] = "GET / HTTP/1.1\r\n\r\n";
+                REQUIRE(send(fd, garbage, sizeof(garbage), 0) == sizeof(garbage));
+
+                THEN("Only the connection should be closed, the event loop keeps running") {
+                    const auto deadline = offset_time_point_by_ms(get_current_time_point(), 5000);
+                    while (not connection_closed and get_current_time_point() < deadline) {
+                        REQUIRE_NOTHROW(poll_manager.poll(10));
+                    }
+
+                    REQUIRE(connection_closed);
+                }
+
+                close(fd);
+            }
+        }
+    }
+
+    std::filesystem::remove_all(directory);
+}
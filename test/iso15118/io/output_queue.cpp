@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include <iso15118/io/output_queue.hpp>
+
+using namespace iso15118;
+
+SCENARIO("Output queue") {
+    io::OutputQueue queue;
+    const std::vector<uint8_t> first{0x01, 0x02, 0x03, 0x04};
+    const std::vector<uint8_t> second{0x05, 0x06};
+
+    GIVEN("An empty queue") {
+        THEN("Nothing should be queued") {
+            REQUIRE(queue.empty());
+            REQUIRE(queue.get_stats().queued_bytes == 0);
+            REQUIRE(queue.get_stats().deferred_writes == 0);
+        }
+    }
+
+    GIVEN("Two deferred writes") {
+        queue.push(first.data(), first.size());
+        queue.push(second.data(), second.size());
+
+        THEN("The bytes should be queued in order") {
+            REQUIRE(queue.size() == 6);
+            REQUIRE(std::vector<uint8_t>(queue.data(), queue.data() + queue.size()) ==
+                    std::vector<uint8_t>{0x01, 0x02, 0x03, 0x04, 0x05, 0x06});
+            REQUIRE(queue.get_stats().queued_bytes == 6);
+            REQUIRE(queue.get_stats().max_queued_bytes == 6);
+            REQUIRE(queue.get_stats().deferred_writes == 2);
+        }
+
+        WHEN("Parts of the queue are written") {
+            queue.consume(3);
+
+            THEN("Only the remaining bytes should be queued") {
+                REQUIRE(queue.size() == 3);
+                REQUIRE(queue.data()[0] == 0x04);
+                REQUIRE(queue.get_stats().queued_bytes == 3);
+                REQUIRE(queue.get_stats().max_queued_bytes == 6);
+            }
+
+            AND_WHEN("The rest is written") {
+                queue.consume(3);
+
+                THEN("The queue should be empty again") {
+                    REQUIRE(queue.empty());
+                    REQUIRE(queue.get_stats().queued_bytes == 0);
+                    REQUIRE(queue.get_stats().max_queued_bytes == 6);
+                }
+            }
+        }
+    }
+}
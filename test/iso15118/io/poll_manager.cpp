@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <iso15118/io/poll_manager.hpp>
+
+using namespace iso15118;
+
+namespace {
+
+struct Pipe {
+    Pipe() {
+        if (::pipe(fds.data()) == -1) {
+            throw std::runtime_error("Failed to create pipe");
+        }
+    }
+    Pipe(const Pipe&) = delete;
+    Pipe& operator=(const Pipe&) = delete;
+    ~Pipe() {
+        close(fds[0]);
+        close(fds[1]);
+    }
+    void write_byte() {
+        const char tmp = 0;
+        if (::write(fds[1], &tmp, 1) != 1) {
+            throw std::runtime_error("Failed to write to pipe");
+        }
+    }
+    void read_byte() {
+        char tmp;
+        if (::read(fds[0], &tmp, 1) != 1) {
+            throw std::runtime_error("Failed to read from pipe");
+        }
+    }
+    int read_fd() const {
+        return fds[0];
+    }
+
+    std::array<int, 2> fds{-1, -1};
+};
+
+} // namespace
+
+static void run_poll_manager_tests(io::PollBackend backend) {
+    GIVEN("A poll manager with " + std::string(backend == io::PollBackend::EPOLL ? "epoll" : "poll") + " backend") {
+        io::PollManager poll_manager(backend);
+        Pipe pipe_a;
+        Pipe pipe_b;
+
+        THEN("The requested backend should be used") {
+            REQUIRE(poll_manager.get_backend() == backend);
+        }
+
+        WHEN("Data is available on a registered fd") {
+            int calls_a = 0;
+            int calls_b = 0;
+            poll_manager.register_fd(pipe_a.read_fd(), [&]() {
+                pipe_a.read_byte();
+                calls_a++;
+            });
+            poll_manager.register_fd(pipe_b.read_fd(), [&]() {
+                pipe_b.read_byte();
+                calls_b++;
+            });
+
+            pipe_a.write_byte();
+            poll_manager.poll(0);
+
+            THEN("Only its callback should be called") {
+                REQUIRE(calls_a == 1);
+                REQUIRE(calls_b == 0);
+            }
+        }
+
+        WHEN("The peer of a registered fd hangs up without sending data") {
+            int calls = 0;
+            poll_manager.register_fd(pipe_a.read_fd(), [&]() {
+                poll_manager.unregister_fd(pipe_a.read_fd());
+                calls++;
+            });
+
+            close(pipe_a.fds[1]);
+            pipe_a.fds[1] = -1;
+            poll_manager.poll(0);
+
+            THEN("Its callback should be called, so it can read the end of the stream") {
+                REQUIRE(calls == 1);
+            }
+        }
+
+        WHEN("A fd is unregistered") {
+            int calls = 0;
+            poll_manager.register_fd(pipe_a.read_fd(), [&calls]() { calls++; });
+            poll_manager.unregister_fd(pipe_a.read_fd());
+
+            pipe_a.write_byte();
+            poll_manager.poll(0);
+
+            THEN("Its callback should not be called anymore") {
+                REQUIRE(calls == 0);
+            }
+        }
+
+        WHEN("A callback unregisters another fd, which is ready in the same wakeup") {
+            int calls = 0;
+            poll_manager.register_fd(pipe_a.read_fd(), [&]() {
+                pipe_a.read_byte();
+                poll_manager.unregister_fd(pipe_b.read_fd());
+                calls++;
+            });
+            poll_manager.register_fd(pipe_b.read_fd(), [&]() {
+                pipe_b.read_byte();
+                poll_manager.unregister_fd(pipe_a.read_fd());
+                calls++;
+            });
+
+            pipe_a.write_byte();
+            pipe_b.write_byte();
+            poll_manager.poll(0);
+
+            THEN("Only one of the callbacks should be called") {
+                REQUIRE(calls == 1);
+            }
+        }
+
+        WHEN("A callback replaces its own registration") {
+            int first_calls = 0;
+            int second_calls = 0;
+            poll_manager.register_fd(pipe_a.read_fd(), [&]() {
+                pipe_a.read_byte();
+                first_calls++;
+                poll_manager.register_fd(pipe_a.read_fd(), [&]() {
+                    pipe_a.read_byte();
+                    second_calls++;
+                });
+            });
+
+            pipe_a.write_byte();
+            poll_manager.poll(0);
+            pipe_a.write_byte();
+            poll_manager.poll(0);
+
+            THEN("The new callback should be used for the next wakeup") {
+                REQUIRE(first_calls == 1);
+                REQUIRE(second_calls == 1);
+            }
+        }
+
+        WHEN("Write interest is set for a writable fd") {
+            int write_calls = 0;
+            const auto write_fd = pipe_a.fds[1];
+            poll_manager.register_fd(write_fd, []() {});
+            poll_manager.set_write_callback(write_fd, [&]() {
+                write_calls++;
+                poll_manager.set_write_interest(write_fd, false);
+            });
+
+            poll_manager.poll(0);
+            REQUIRE(write_calls == 0);
+
+            poll_manager.set_write_interest(write_fd, true);
+            poll_manager.poll(0);
+            poll_manager.poll(0);
+
+            THEN("The write callback should be called until the interest is cleared") {
+                REQUIRE(write_calls == 1);
+            }
+        }
+
+        WHEN("Timers are scheduled") {
+            std::vector<int> fired;
+            const auto now = get_current_time_point();
+            poll_manager.schedule_timer(offset_time_point_by_ms(now, 20), [&fired]() { fired.push_back(2); });
+            poll_manager.schedule_timer(offset_time_point_by_ms(now, 10), [&fired]() { fired.push_back(1); });
+            const auto cancelled =
+                poll_manager.schedule_timer(offset_time_point_by_ms(now, 5), [&fired]() { fired.push_back(0); });
+            poll_manager.cancel_timer(cancelled);
+
+            while (fired.size() < 2) {
+                poll_manager.poll(-1);
+            }
+
+            THEN("They should fire in order of their deadlines, but not before") {
+                REQUIRE(get_current_time_point() >= offset_time_point_by_ms(now, 20));
+                REQUIRE(fired == std::vector<int>{1, 2});
+            }
+        }
+
+        WHEN("A timer with a deadline in the past is scheduled") {
+            bool fired = false;
+            poll_manager.schedule_timer(offset_time_point_by_ms(get_current_time_point(), -10),
+                                        [&fired]() { fired = true; });
+            poll_manager.poll(-1);
+
+            THEN("It should fire on the next wakeup") {
+                REQUIRE(fired);
+            }
+        }
+
+        WHEN("The poll manager gets notified while a fd is ready") {
+            int notify_calls = 0;
+            int calls = 0;
+            poll_manager.set_notify_callback([&notify_calls]() { notify_calls++; });
+            poll_manager.register_fd(pipe_a.read_fd(), [&]() {
+                pipe_a.read_byte();
+                calls++;
+            });
+
+            pipe_a.write_byte();
+            poll_manager.notify();
+            poll_manager.notify();
+            poll_manager.poll(-1);
+
+            THEN("The notify callback should be called once and the fd event should not be skipped") {
+                REQUIRE(notify_calls == 1);
+                REQUIRE(calls == 1);
+            }
+        }
+
+        WHEN("The poll manager gets notified from another thread") {
+            bool notified = false;
+            poll_manager.set_notify_callback([&notified]() { notified = true; });
+
+            std::thread notifier([&poll_manager]() { poll_manager.notify(); });
+            while (not notified) {
+                poll_manager.poll(-1);
+            }
+            notifier.join();
+
+            THEN("Poll should wake up and call the notify callback") {
+                REQUIRE(notified);
+            }
+        }
+
+        WHEN("The poll manager gets aborted") {
+            poll_manager.abort();
+            poll_manager.poll(-1);
+
+            THEN("Poll should return") {
+                SUCCEED();
+            }
+        }
+    }
+}
+
+SCENARIO("Poll manager with poll backend") {
+    run_poll_manager_tests(io::PollBackend::POLL);
+}
+
+SCENARIO("Poll manager with epoll backend") {
+    run_poll_manager_tests(io::PollBackend::EPOLL);
+}
+
+TEST_CASE("Poll manager wakeup cost", "[.][benchmark]") {
+    for (const auto backend : {io::PollBackend::POLL, io::PollBackend::EPOLL}) {
+        const std::string backend_name = (backend == io::PollBackend::EPOLL) ? "epoll" : "poll";
+
+        for (const auto fd_count : {1, 8, 64}) {
+            io::PollManager poll_manager(backend);
+            std::vector<Pipe> pipes(fd_count);
+
+            for (auto& pipe : pipes) {
+                poll_manager.register_fd(pipe.read_fd(), [&pipe]() { pipe.read_byte(); });
+            }
+
+            auto& ready_pipe = pipes.back();
+
+            BENCHMARK(backend_name + " wakeup with " + std::to_string(fd_count) + " fds") {
+                ready_pipe.write_byte();
+                poll_manager.poll(0);
+            };
+        }
+    }
+}
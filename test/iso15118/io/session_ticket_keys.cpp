@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include <iso15118/detail/io/session_ticket_keys.hpp>
+
+using namespace iso15118;
+using namespace std::chrono_literals;
+
+SCENARIO("Session ticket key store") {
+    const auto now = io::SessionTicketKeyStore::Clock::now();
+
+    GIVEN("A store with a rotation interval") {
+        io::SessionTicketKeyStore store(1h, {});
+        const auto first = store.get_encryption_key(now);
+
+        THEN("The key should be kept within the interval") {
+            const auto key = store.get_encryption_key(now + 30min);
+            REQUIRE(key.name == first.name);
+
+            const auto lookup = store.find_decryption_key(first.name.data(), now + 30min);
+            REQUIRE(lookup.has_value());
+            REQUIRE_FALSE(lookup->renew_ticket);
+            REQUIRE(lookup->key.aes_key == first.aes_key);
+        }
+
+        THEN("After the interval, the previous key should still decrypt but renew the ticket") {
+            const auto second = store.get_encryption_key(now + 90min);
+            REQUIRE(second.name != first.name);
+
+            const auto lookup = store.find_decryption_key(first.name.data(), now + 90min);
+            REQUIRE(lookup.has_value());
+            REQUIRE(lookup->renew_ticket);
+        }
+
+        THEN("After two intervals, the first key should be expired") {
+            store.get_encryption_key(now + 90min);
+            REQUIRE_FALSE(store.find_decryption_key(first.name.data(), now + 150min).has_value());
+        }
+
+        THEN("An unknown key should not be found") {
+            auto name = first.name;
+            name[0] ^= 0xff;
+            REQUIRE_FALSE(store.find_decryption_key(name.data(), now).has_value());
+        }
+    }
+
+    GIVEN("A store without rotation") {
+        io::SessionTicketKeyStore store(0s, {});
+        const auto first = store.get_encryption_key(now);
+
+        THEN("The key should never change") {
+            REQUIRE(store.get_encryption_key(now + 24h * 365).name == first.name);
+        }
+    }
+
+    GIVEN("A store backed by a file") {
+        const auto file = std::filesystem::temp_directory_path() / "iso15118_test_session_ticket.keys";
+        std::filesystem::remove(file);
+
+        const auto first = io::SessionTicketKeyStore(1h, file).get_encryption_key();
+
+        THEN("The keys should be restored by another store") {
+            io::SessionTicketKeyStore restored(1h, file);
+            REQUIRE(restored.get_encryption_key().name == first.name);
+            REQUIRE(restored.find_decryption_key(first.name.data()).has_value());
+        }
+
+        THEN("The file should only be accessible by the owner") {
+            const auto perms = std::filesystem::status(file).permissions();
+            REQUIRE(perms == (std::filesystem::perms::owner_read | std::filesystem::perms::owner_write));
+        }
+
+        THEN("A leftover temporary file should not pass its permissions on") {
+            auto tmp_file = file;
+            tmp_file += ".tmp";
+            std::ofstream(tmp_file) << "leftover";
+            std::filesystem::permissions(tmp_file, std::filesystem::perms::all);
+
+            std::filesystem::remove(file);
+            io::SessionTicketKeyStore recreated(1h, file);
+
+            const auto perms = std::filesystem::status(file).permissions();
+            REQUIRE(perms == (std::filesystem::perms::owner_read | std::filesystem::perms::owner_write));
+        }
+
+        THEN("An invalid file should be replaced by new keys") {
+            std::ofstream(file, std::ios::trunc) << "invalid";
+
+            io::SessionTicketKeyStore replaced(1h, file);
+            REQUIRE(replaced.get_encryption_key().name != first.name);
+        }
+
+        std::filesystem::remove(file);
+    }
+}
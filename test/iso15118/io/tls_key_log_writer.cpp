@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <iso15118/detail/io/tls_key_log_writer.hpp>
+
+using namespace iso15118;
+
+namespace {
+std::vector<std::string> read_lines(const std::filesystem::path& file) {
+    std::vector<std::string> lines;
+    std::ifstream in(file);
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+} // namespace
+
+SCENARIO("TLS key log writer") {
+    const auto file = std::filesystem::temp_directory_path() / "iso15118_test_tls_session_keys.log";
+    std::filesystem::remove(file);
+
+    GIVEN("A writer with some pushed lines") {
+        {
+            io::TlsKeyLogWriter writer(file);
+            writer.push("CLIENT_RANDOM 01 02", nullptr);
+            writer.push("CLIENT_RANDOM 03 04", nullptr);
+        }
+
+        THEN("The lines should be in the file once the writer is gone") {
+            REQUIRE(read_lines(file) == std::vector<std::string>{"CLIENT_RANDOM 01 02", "CLIENT_RANDOM 03 04"});
+        }
+    }
+
+    GIVEN("A writer, that is destroyed right after pushing") {
+        {
+            io::TlsKeyLogWriter writer(file);
+            for (auto i = 0; i < 100; ++i) {
+                writer.push(("SERVER_TRAFFIC_SECRET_0 " + std::to_string(i)).c_str(), nullptr);
+            }
+        }
+
+        THEN("No line should be lost") {
+            const auto lines = read_lines(file);
+            REQUIRE(lines.size() == 100);
+            REQUIRE(lines.back() == "SERVER_TRAFFIC_SECRET_0 99");
+        }
+    }
+
+    GIVEN("An existing key log file") {
+        std::ofstream(file) << "CLIENT_RANDOM aa bb" << std::endl;
+
+        THEN("New lines should be appended") {
+            {
+                io::TlsKeyLogWriter writer(file);
+                writer.push("CLIENT_RANDOM cc dd", nullptr);
+            }
+            REQUIRE(read_lines(file) == std::vector<std::string>{"CLIENT_RANDOM aa bb", "CLIENT_RANDOM cc dd"});
+        }
+    }
+
+    std::filesystem::remove(file);
+}
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include <iso15118/io/v2gtp_reader.hpp>
+
+using namespace iso15118;
+
+namespace {
+
+// hands out the queued chunks, one chunk per read
+class ChunkConnection : public io::IConnection {
+public:
+    void push_chunk(std::vector<uint8_t> chunk) {
+        chunks.push_back(std::move(chunk));
+    }
+
+    void set_event_callback(const io::ConnectionEventCallback&) final {
+    }
+    io::Ipv6EndPoint get_public_endpoint() const final {
+        return {};
+    }
+    void write(const uint8_t*, size_t) final {
+    }
+    io::ReadResult read(uint8_t* buf, size_t len) final {
+        read_calls++;
+        if (chunks.empty()) {
+            return {true, 0};
+        }
+
+        auto& chunk = chunks.front();
+        const auto bytes_read = std::min(len, chunk.size());
+        std::memcpy(buf, chunk.data(), bytes_read);
+        chunk.erase(chunk.begin(), chunk.begin() + bytes_read);
+        if (chunk.empty()) {
+            chunks.pop_front();
+        }
+
+        return {bytes_read < len, bytes_read};
+    }
+    void close() final {
+    }
+    void linger_and_close(uint32_t) final {
+    }
+    std::optional<io::sha512_hash_t> get_vehicle_cert_hash() const final {
+        return std::nullopt;
+    }
+    io::OutputQueueStats get_output_queue_stats() const final {
+        return {};
+    }
+
+    int read_calls{0};
+
+private:
+    std::deque<std::vector<uint8_t>> chunks;
+};
+
+std::vector<uint8_t> make_frame(uint16_t payload_type, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame{0x01, 0xfe, static_cast<uint8_t>(payload_type >> 8),
+                               static_cast<uint8_t>(payload_type & 0xff)};
+    const auto length = static_cast<uint32_t>(payload.size());
+    frame.push_back(length >> 24);
+    frame.push_back((length >> 16) & 0xff);
+    frame.push_back((length >> 8) & 0xff);
+    frame.push_back(length & 0xff);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return frame;
+}
+
+std::vector<uint8_t> to_vector(const io::StreamInputView& view) {
+    return {view.payload, view.payload + view.payload_len};
+}
+
+} // namespace
+
+SCENARIO("V2GTP reader") {
+    io::V2gtpReader reader;
+    ChunkConnection connection;
+
+    GIVEN("Two frames coalesced in a single read") {
+        auto data = make_frame(0x8002, {0x80, 0x8c, 0x01});
+        const auto second = make_frame(0x8004, {0x80, 0x34});
+        data.insert(data.end(), second.begin(), second.end());
+        connection.push_chunk(data);
+
+        const auto would_block = reader.fill(connection);
+
+        THEN("Both frames should be parsed with a single read") {
+            REQUIRE(would_block);
+            REQUIRE(connection.read_calls == 1);
+
+            const auto first_frame = reader.next_frame();
+            REQUIRE(first_frame.has_value());
+            REQUIRE(first_frame->payload_type == io::v2gtp::PayloadType::Part20Main);
+            REQUIRE(to_vector(first_frame->payload) == std::vector<uint8_t>{0x80, 0x8c, 0x01});
+
+            const auto second_frame = reader.next_frame();
+            REQUIRE(second_frame.has_value());
+            REQUIRE(second_frame->payload_type == io::v2gtp::PayloadType::Part20DC);
+            REQUIRE(to_vector(second_frame->payload) == std::vector<uint8_t>{0x80, 0x34});
+
+            REQUIRE(reader.next_frame().has_value() == false);
+            REQUIRE(reader.get_buffered_bytes() == 0);
+            REQUIRE(reader.get_state() == io::V2gtpReader::State::OK);
+        }
+    }
+
+    GIVEN("A frame split within its header") {
+        const auto frame = make_frame(0x8001, {0x80, 0x00, 0xf3});
+        connection.push_chunk({frame.begin(), frame.begin() + 5});
+        connection.push_chunk({frame.begin() + 5, frame.end()});
+
+        reader.fill(connection);
+
+        THEN("The frame should be available after the second read") {
+            REQUIRE(reader.next_frame().has_value() == false);
+            REQUIRE(reader.get_buffered_bytes() == 5);
+
+            reader.fill(connection);
+
+            const auto parsed = reader.next_frame();
+            REQUIRE(parsed.has_value());
+            REQUIRE(parsed->payload_type == io::v2gtp::PayloadType::SAP);
+            REQUIRE(to_vector(parsed->payload) == std::vector<uint8_t>{0x80, 0x00, 0xf3});
+        }
+    }
+
+    GIVEN("A partial frame behind a complete one") {
+        const auto first = make_frame(0x8004, std::vector<uint8_t>(100, 0xaa));
+        const auto second = make_frame(0x8004, std::vector<uint8_t>(1500, 0xbb));
+        auto data = first;
+        data.insert(data.end(), second.begin(), second.begin() + 10);
+        connection.push_chunk(data);
+        connection.push_chunk({second.begin() + 10, second.end()});
+
+        reader.fill(connection);
+
+        THEN("The partial frame should be moved to the front and completed by the next read") {
+            REQUIRE(reader.next_frame().has_value());
+            REQUIRE(reader.next_frame().has_value() == false);
+
+            reader.fill(connection);
+
+            const auto parsed = reader.next_frame();
+            REQUIRE(parsed.has_value());
+            REQUIRE(to_vector(parsed->payload) == std::vector<uint8_t>(1500, 0xbb));
+        }
+    }
+
+    GIVEN("A frame with an invalid protocol version") {
+        auto frame = make_frame(0x8002, {0x80});
+        frame[1] = 0x00;
+        connection.push_chunk(frame);
+
+        reader.fill(connection);
+
+        THEN("The reader should fail") {
+            REQUIRE(reader.next_frame().has_value() == false);
+            REQUIRE(reader.get_state() == io::V2gtpReader::State::INVALID_HEADER);
+        }
+    }
+
+    GIVEN("A frame which exceeds the maximum frame size") {
+        const auto frame = make_frame(0x8002, std::vector<uint8_t>(io::V2gtpReader::MAX_FRAME_SIZE, 0x00));
+        connection.push_chunk({frame.begin(), frame.begin() + 16});
+
+        reader.fill(connection);
+
+        THEN("The reader should fail") {
+            REQUIRE(reader.next_frame().has_value() == false);
+            REQUIRE(reader.get_state() == io::V2gtpReader::State::PAYLOAD_TO_LONG);
+        }
+    }
+}
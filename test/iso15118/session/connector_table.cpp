@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <iso15118/connector_table.hpp>
+#include <iso15118/io/event_loop.hpp>
+
+using namespace iso15118;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct FakeSession {
+    std::vector<d20::ControlEvent> events;
+    std::vector<std::thread::id> threads;
+
+    void push_control_event(const d20::ControlEvent& event) {
+        events.push_back(event);
+        threads.push_back(std::this_thread::get_id());
+    }
+};
+
+// shard running within its own thread
+struct TestShard {
+    TestShard() {
+        loop.start([this]() {
+            if (not started) {
+                started = true;
+                thread_promise.set_value(std::this_thread::get_id());
+            }
+        });
+        thread = thread_promise.get_future().get();
+    }
+
+    void post(std::function<void()> task) {
+        loop.post(std::move(task));
+    }
+
+    // waits until all tasks posted so far have run
+    void sync() {
+        std::promise<void> done;
+        loop.post([&done]() { done.set_value(); });
+        REQUIRE(done.get_future().wait_for(5s) == std::future_status::ready);
+    }
+
+    // NOTE: declared ahead of the loop, because its thread uses them until the loop is gone
+    std::promise<std::thread::id> thread_promise;
+    bool started{false};
+
+    io::EventLoop loop;
+    std::thread::id thread;
+};
+
+struct FakeConnector {
+    std::mutex mutex;
+    TestShard* shard{nullptr};
+    std::unique_ptr<FakeSession> session;
+};
+
+} // namespace
+
+SCENARIO("Routing of control events to the sessions of the connectors") {
+    GIVEN("Two connectors with a session each, running within different shards") {
+        TestShard shard_a;
+        TestShard shard_b;
+
+        ConnectorTable<FakeConnector> connectors;
+        auto& connector_a = *connectors.add("eth0");
+        auto& connector_b = *connectors.add("eth1");
+
+        connector_a.shard = &shard_a;
+        connector_a.session = std::make_unique<FakeSession>();
+        connector_b.shard = &shard_b;
+        connector_b.session = std::make_unique<FakeSession>();
+
+        THEN("A connector should not be added twice") {
+            REQUIRE(connectors.add("eth0") == nullptr);
+        }
+
+        THEN("The first connector should be the default one") {
+            REQUIRE(connectors.get_default_name() == "eth0");
+        }
+
+        THEN("Unknown connectors should be rejected") {
+            REQUIRE_THROWS_AS(connectors.push_control_event("eth2", d20::StopCharging{true}), std::runtime_error);
+        }
+
+        WHEN("Control events are sent to the second connector") {
+            connectors.push_control_event("eth1", d20::CableCheckFinished{true});
+            connectors.push_control_event("eth1", d20::StopCharging{true});
+            shard_a.sync();
+            shard_b.sync();
+
+            THEN("Only its session should get them, within the thread of its shard") {
+                REQUIRE(connector_a.session->events.empty());
+
+                const auto& session_b = *connector_b.session;
+                REQUIRE(session_b.events.size() == 2);
+                REQUIRE(std::holds_alternative<d20::CableCheckFinished>(session_b.events[0]));
+                REQUIRE(std::holds_alternative<d20::StopCharging>(session_b.events[1]));
+                REQUIRE(session_b.threads == std::vector<std::thread::id>{shard_b.thread, shard_b.thread});
+            }
+        }
+
+        WHEN("Control events are sent to both connectors") {
+            connectors.push_control_event("eth0", d20::StopCharging{true});
+            connectors.push_control_event("eth1", d20::CableCheckFinished{true});
+            shard_a.sync();
+            shard_b.sync();
+
+            THEN("Each session should get its own event") {
+                REQUIRE(connector_a.session->events.size() == 1);
+                REQUIRE(std::holds_alternative<d20::StopCharging>(connector_a.session->events[0]));
+                REQUIRE(connector_a.session->threads.front() == shard_a.thread);
+
+                REQUIRE(connector_b.session->events.size() == 1);
+                REQUIRE(std::holds_alternative<d20::CableCheckFinished>(connector_b.session->events[0]));
+                REQUIRE(connector_b.session->threads.front() == shard_b.thread);
+            }
+        }
+
+        WHEN("The session of a connector finished") {
+            std::unique_ptr<FakeSession> finished_session;
+            {
+                std::scoped_lock lock(connector_b.mutex);
+                connector_b.shard = nullptr;
+                finished_session = std::move(connector_b.session);
+            }
+
+            connectors.push_control_event("eth1", d20::StopCharging{true});
+            shard_b.sync();
+
+            THEN("Its events should be dropped") {
+                REQUIRE(finished_session->events.empty());
+            }
+
+            THEN("The other connector should not be affected") {
+                connectors.push_control_event("eth0", d20::StopCharging{true});
+                shard_a.sync();
+                REQUIRE(connector_a.session->events.size() == 1);
+            }
+        }
+
+        WHEN("The session of a connector is replaced, before its pending events have been handed over") {
+            std::promise<void> resume;
+            auto resume_future = resume.get_future();
+            // keeps the shard busy, so the event stays pending
+            shard_b.post([&resume_future]() { resume_future.wait(); });
+
+            connectors.push_control_event("eth1", d20::StopCharging{true});
+
+            {
+                std::scoped_lock lock(connector_b.mutex);
+                connector_b.shard = &shard_a;
+                connector_b.session = std::make_unique<FakeSession>();
+            }
+
+            resume.set_value();
+            shard_b.sync();
+
+            THEN("The new session should not get the events of the previous one") {
+                REQUIRE(connector_b.session->events.empty());
+            }
+        }
+    }
+}
@@ -778,6 +778,53 @@ SCENARIO("DC charge loop state handling") {
         }
     }
 
+    GIVEN("Good case - DC dynamic mode with a prepared control mode block") {
+        d20::SelectedServiceParameters service_parameters =
+            d20::SelectedServiceParameters(dt::ServiceCategory::DC, dt::DcConnector::Extended, dt::ControlMode::Dynamic,
+                                           dt::MobilityNeedsMode::ProvidedBySecc, dt::Pricing::NoPricing);
+
+        d20::Session session = d20::Session(service_parameters);
+
+        const d20::UpdateDynamicModeParameters dynamic_parameters = {std::time(nullptr) + 60, 95, std::nullopt};
+
+        const auto control_mode =
+            d20::state::create_control_mode_response(service_parameters, evse_setup.dc_limits, dynamic_parameters);
+
+        message_20::DC_ChargeLoopRequest req;
+        req.header.session_id = session.get_id();
+        req.header.timestamp = 1691411798;
+        req.control_mode.emplace<Dynamic_DC_Req>();
+        req.present_voltage = {330, 0};
+
+        const auto res = d20::state::handle_request(message_20::DC_ChargeLoopRequestView(req), session, 330, 30, false,
+                                                    false, control_mode, dynamic_parameters);
+
+        THEN("The block should not contain the departure time, but the response should") {
+            REQUIRE(control_mode.has_value());
+            REQUIRE(std::get<Dynamic_DC_Res>(*control_mode).departure_time.has_value() == false);
+
+            REQUIRE(res.response_code == dt::ResponseCode::OK);
+            REQUIRE(std::holds_alternative<Dynamic_DC_Res>(res.control_mode));
+            const auto& res_control_mode = std::get<Dynamic_DC_Res>(res.control_mode);
+            REQUIRE(dt::from_RationalNumber(res_control_mode.max_charge_power) == 22000.0f);
+            REQUIRE(res_control_mode.departure_time.value_or(0) >= 59);
+            REQUIRE(res_control_mode.target_soc.value_or(0) == 95);
+        }
+    }
+
+    GIVEN("Bad case - DC_BPT without discharge limits") {
+        d20::SelectedServiceParameters service_parameters = d20::SelectedServiceParameters(
+            dt::ServiceCategory::DC_BPT, dt::DcConnector::Extended, dt::ControlMode::Scheduled,
+            dt::MobilityNeedsMode::ProvidedByEvcc, dt::Pricing::NoPricing);
+
+        auto limits = evse_setup.dc_limits;
+        limits.discharge_limits.reset();
+
+        THEN("No control mode block should be created") {
+            REQUIRE(d20::state::create_control_mode_response(service_parameters, limits, {}).has_value() == false);
+        }
+    }
+
     // Note(sl): Only in scheduled mode and if a powertolerance was sent from the secc
     // TODO(sl): Adding test
     // GIVEN("Warning case - Warning_EVPowerProfileViolation [V2G20-1864]") {}